@@ -4,6 +4,8 @@
 #include <sstream>
 #include <string>
 
+#include "../utility/trace.h"
+
 // 基类：负责将请求交给当前节点处理；若无法处理则传给下一个
 class InputHandler
 {
@@ -22,7 +24,7 @@ public:
         {
             if (handle_input_impl(token))
             {
-                std::printf("[Handled by %s] %s\n", handler_name(), token.c_str());
+                TRACE_DEBUG("[Handled by {}] {}", handler_name(), token);
                 return; // 当前节点处理成功 -> 终止链
             }
         }
@@ -33,7 +35,7 @@ public:
         }
         else
         {
-            std::printf("[Unhandled] %s\n", input.c_str());
+            TRACE_DEBUG("[Unhandled] {}", input);
         }
     }
 
@@ -95,7 +97,7 @@ public:
 protected:
     bool handle_input_impl(const std::string &token) override
     {
-        std::printf("[Fallback handles] %s\n", token.c_str());
+        TRACE_DEBUG("[Fallback handles] {}", token);
         return true;
     }
 
@@ -114,4 +116,5 @@ inline void chain_of_responsibility()
     ui->handle_input("ui");
     ui->handle_input("player");
     ui->handle_input("unknown input");
+    trace::flush();
 }
@@ -4,18 +4,83 @@
 #include <string>
 #include <vector>
 
+class SceneNode;
+
+// 结构变化的观察者（如路径索引）：在根节点上 set_observer，之后整棵树的增删都会通知到它
+// 通知以子树为单位：on_attach 在子树挂上之后调用，on_detach 在子树摘下之前调用（此时父链接仍然有效）
+class SceneObserver
+{
+public:
+    virtual ~SceneObserver() = default;
+    virtual void on_attach(SceneNode &subtree) = 0;
+    virtual void on_detach(SceneNode &subtree) = 0;
+};
+
 // SceneNode：对外隐藏 children 容器，通过接口供迭代器访问
 class SceneNode
 {
 public:
     explicit SceneNode(std::string name) : m_name(std::move(name)) {}
 
+    // 子节点可能被别处的 shared_ptr 继续持有：清掉它们的父链接（以及观察者），避免悬空
+    ~SceneNode()
+    {
+        for (auto &child : m_children)
+        {
+            child->m_parent = nullptr;
+            if (m_observer)
+            {
+                child->assign_observer(nullptr);
+            }
+        }
+    }
+
+    SceneNode(const SceneNode &) = delete;
+    SceneNode &operator=(const SceneNode &) = delete;
+
+    // child 已经挂在别的节点下时，先从原父节点摘下（原树的观察者会收到 on_detach）
     void add_child(std::shared_ptr<SceneNode> child)
     {
+        if (SceneNode *old_parent = child->m_parent)
+        {
+            old_parent->remove_child(old_parent->index_of(child.get()));
+        }
+        child->m_parent = this;
         m_children.emplace_back(std::move(child));
+        SceneNode &added = *m_children.back();
+        if (m_observer || added.m_observer)
+        {
+            added.assign_observer(m_observer);
+        }
+        if (m_observer)
+        {
+            m_observer->on_attach(added);
+        }
+    }
+
+    // 摘下第 idx 个子节点（连同整棵子树），返回它；越界返回 nullptr
+    std::shared_ptr<SceneNode> remove_child(std::size_t idx)
+    {
+        if (idx >= m_children.size())
+        {
+            return nullptr;
+        }
+        if (m_observer)
+        {
+            m_observer->on_detach(*m_children[idx]);
+            m_children[idx]->assign_observer(nullptr);
+        }
+        std::shared_ptr<SceneNode> child = std::move(m_children[idx]);
+        m_children.erase(m_children.begin() + static_cast<std::ptrdiff_t>(idx));
+        child->m_parent = nullptr;
+        return child;
     }
 
+    // 设置在根节点上，整棵树共享；传 nullptr 取消。O(树的大小)，之后增删只影响变动的子树
+    void set_observer(SceneObserver *observer) { assign_observer(observer); }
+
     const std::string &name() const { return m_name; }
+    SceneNode *parent() const { return m_parent; }
     std::size_t child_count() const { return m_children.size(); }
 
     std::shared_ptr<SceneNode> child_at(std::size_t idx) const
@@ -27,9 +92,48 @@ public:
         return m_children[idx];
     }
 
+    // 不复制 shared_ptr 的子节点访问（遍历用，不改变引用计数）
+    SceneNode *child_node(std::size_t idx) const
+    {
+        return idx < m_children.size() ? m_children[idx].get() : nullptr;
+    }
+
 private:
+    std::size_t index_of(const SceneNode *child) const
+    {
+        std::size_t idx = 0;
+        while (idx < m_children.size() && m_children[idx].get() != child)
+        {
+            ++idx;
+        }
+        return idx;
+    }
+
+    // 观察者指针记在子树的每个节点上，增删时不必沿父链接找根
+    void assign_observer(SceneObserver *observer)
+    {
+        if (m_children.empty())
+        {
+            m_observer = observer; // 单个节点（最常见的 add_child）不用开栈
+            return;
+        }
+        std::vector<SceneNode *> stack{this};
+        while (!stack.empty())
+        {
+            SceneNode *node = stack.back();
+            stack.pop_back();
+            node->m_observer = observer;
+            for (auto &child : node->m_children)
+            {
+                stack.push_back(child.get());
+            }
+        }
+    }
+
     std::string m_name;
     std::vector<std::shared_ptr<SceneNode>> m_children;
+    SceneNode *m_parent{nullptr};
+    SceneObserver *m_observer{nullptr};
 };
 
 // SceneIterator：持有 SceneNode 引用与游标，封装遍历逻辑
@@ -0,0 +1,364 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "iterator_tree.h"
+
+// FlatScene：扁平化的场景存储，适合百万级节点
+// - 节点用下标（NodeId）表示，各字段分别存放在连续数组里（SoA），没有逐节点的堆分配
+// - 节点按先序（DFS）排列时，整棵树的遍历就是从 0 到 size() 的线性扫描，父节点总在子节点之前
+// - 名字驻留：相同名字只存一份，节点只记名字编号
+// - add_child 只在“追加到先序末尾”时保持先序；否则标记为无序，遍历退回按链接走，
+//   compact() 重新排成先序（会改变 NodeId，返回旧 id 到新 id 的映射）
+// - add_child 沿祖先链更新子树大小，O(深度)；批量构建用 from_tree，整体 O(N)，与树的形状无关
+class FlatScene
+{
+public:
+    using NodeId = std::uint32_t;
+    static constexpr NodeId kNone = UINT32_MAX;
+
+    explicit FlatScene(std::string_view root_name = "Root")
+    {
+        append(kNone, root_name);
+        m_last_path.push_back(root());
+    }
+
+    // 驻留表的键引用 m_names 里的字符串：可以移动，不能复制
+    FlatScene(const FlatScene &) = delete;
+    FlatScene &operator=(const FlatScene &) = delete;
+    FlatScene(FlatScene &&) = default;
+    FlatScene &operator=(FlatScene &&) = default;
+
+    NodeId root() const { return 0; }
+    std::size_t size() const { return m_parent.size(); }
+    bool dfs_ordered() const { return m_dfs_ordered; }
+
+    // 追加为 parent 的最后一个子节点，返回新节点
+    NodeId add_child(NodeId parent, std::string_view name)
+    {
+        // 新节点排在先序末尾的条件：parent 在“根到最后一个节点”的路径上；
+        // 路径按深度存放，判断只需比较 m_last_path[depth(parent)]
+        if (m_dfs_ordered)
+        {
+            const std::uint32_t depth = m_depth[parent];
+            m_dfs_ordered = depth < m_last_path.size() && m_last_path[depth] == parent;
+        }
+        const NodeId id = append(parent, name);
+        if (m_dfs_ordered)
+        {
+            m_last_path.resize(m_depth[id]);
+            m_last_path.push_back(id);
+        }
+        for (NodeId n = parent; n != kNone; n = m_parent[n])
+        {
+            ++m_subtree_size[n];
+        }
+        return id;
+    }
+
+    const std::string &name(NodeId id) const { return m_names[m_name[id]]; }
+    std::uint32_t name_id(NodeId id) const { return m_name[id]; }
+    NodeId parent(NodeId id) const { return m_parent[id]; }
+    std::size_t depth(NodeId id) const { return m_depth[id]; }
+    std::size_t child_count(NodeId id) const { return m_child_count[id]; }
+    std::size_t subtree_size(NodeId id) const { return m_subtree_size[id]; }
+    NodeId first_child(NodeId id) const { return m_first_child[id]; }
+    NodeId next_sibling(NodeId id) const { return m_next_sibling[id]; }
+
+    // 与 SceneNode::child_at 对应：越界返回 kNone；沿兄弟链前进，O(idx)
+    NodeId child_at(NodeId id, std::size_t idx) const
+    {
+        if (idx >= m_child_count[id])
+        {
+            return kNone;
+        }
+        NodeId child = m_first_child[id];
+        while (idx-- > 0)
+        {
+            child = m_next_sibling[child];
+        }
+        return child;
+    }
+
+    // 先序遍历 id 的整棵子树：fn(NodeId)
+    template <typename Fn>
+    void for_each_preorder(NodeId id, Fn &&fn) const
+    {
+        if (m_dfs_ordered)
+        {
+            const NodeId end = id + static_cast<NodeId>(m_subtree_size[id]);
+            for (NodeId n = id; n < end; ++n)
+            {
+                fn(n); // 先序排列：子树就是一段连续区间
+            }
+            return;
+        }
+        std::vector<NodeId> stack{id};
+        while (!stack.empty())
+        {
+            const NodeId n = stack.back();
+            stack.pop_back();
+            fn(n);
+            const std::size_t first = stack.size();
+            for (NodeId c = m_first_child[n]; c != kNone; c = m_next_sibling[c])
+            {
+                stack.push_back(c);
+            }
+            std::reverse(stack.begin() + static_cast<std::ptrdiff_t>(first), stack.end());
+        }
+    }
+
+    // 重新按先序排列，返回 remap[旧 id] = 新 id
+    std::vector<NodeId> compact()
+    {
+        std::vector<NodeId> order;
+        order.reserve(size());
+        for_each_preorder(root(), [&order](NodeId n) { order.push_back(n); });
+        std::vector<NodeId> remap(size());
+        for (NodeId i = 0; i < order.size(); ++i)
+        {
+            remap[order[i]] = i;
+        }
+        auto relink = [&remap](NodeId n) { return n == kNone ? kNone : remap[n]; };
+
+        FlatScene next;
+        next.m_names = std::move(m_names);
+        next.m_name_ids = std::move(m_name_ids);
+        next.resize(size());
+        for (NodeId i = 0; i < order.size(); ++i)
+        {
+            const NodeId old = order[i];
+            next.m_name[i] = m_name[old];
+            next.m_parent[i] = relink(m_parent[old]);
+            next.m_first_child[i] = relink(m_first_child[old]);
+            next.m_last_child[i] = relink(m_last_child[old]);
+            next.m_next_sibling[i] = relink(m_next_sibling[old]);
+            next.m_child_count[i] = m_child_count[old];
+            next.m_subtree_size[i] = m_subtree_size[old];
+            next.m_depth[i] = m_depth[old];
+        }
+        next.reset_last_path();
+        *this = std::move(next);
+        return remap;
+    }
+
+    // 从指针树构建，结果按先序排列：节点按先序直接追加，不逐个沿祖先链更新，
+    // 最后倒序扫一遍累加子树大小（先序中子节点总在父节点之后），整体 O(N)
+    static FlatScene from_tree(SceneNode &root)
+    {
+        FlatScene scene(root.name());
+        std::vector<std::pair<SceneNode *, NodeId>> stack;
+        for (std::size_t i = root.child_count(); i-- > 0;)
+        {
+            stack.push_back({root.child_node(i), scene.root()});
+        }
+        while (!stack.empty())
+        {
+            const auto [node, parent] = stack.back();
+            stack.pop_back();
+            const NodeId id = scene.append(parent, node->name());
+            for (std::size_t i = node->child_count(); i-- > 0;)
+            {
+                stack.push_back({node->child_node(i), id});
+            }
+        }
+        for (NodeId n = static_cast<NodeId>(scene.size() - 1); n > 0; --n)
+        {
+            scene.m_subtree_size[scene.m_parent[n]] += scene.m_subtree_size[n];
+        }
+        scene.reset_last_path();
+        return scene;
+    }
+
+private:
+    NodeId append(NodeId parent, std::string_view name)
+    {
+        const NodeId id = static_cast<NodeId>(size());
+        resize(size() + 1);
+        m_name[id] = intern(name);
+        m_parent[id] = parent;
+        m_first_child[id] = kNone;
+        m_last_child[id] = kNone;
+        m_next_sibling[id] = kNone;
+        m_child_count[id] = 0;
+        m_subtree_size[id] = 1;
+        m_depth[id] = parent == kNone ? 0 : m_depth[parent] + 1;
+        if (parent != kNone)
+        {
+            if (m_last_child[parent] == kNone) m_first_child[parent] = id;
+            else m_next_sibling[m_last_child[parent]] = id;
+            m_last_child[parent] = id;
+            ++m_child_count[parent];
+        }
+        return id;
+    }
+
+    // 从最后一个节点沿父链接重建“根到最后一个节点”的路径
+    void reset_last_path()
+    {
+        m_last_path.assign(m_depth.back() + 1, kNone);
+        for (NodeId n = static_cast<NodeId>(size() - 1); n != kNone; n = m_parent[n])
+        {
+            m_last_path[m_depth[n]] = n;
+        }
+    }
+
+    std::uint32_t intern(std::string_view name)
+    {
+        auto it = m_name_ids.find(name);
+        if (it != m_name_ids.end())
+        {
+            return it->second;
+        }
+        const auto id = static_cast<std::uint32_t>(m_names.size());
+        m_names.emplace_back(name); // deque：扩容时已有字符串不搬家，键里的 string_view 保持有效
+        m_name_ids.emplace(m_names.back(), id);
+        return id;
+    }
+
+    void resize(std::size_t n)
+    {
+        m_name.resize(n);
+        m_parent.resize(n);
+        m_first_child.resize(n);
+        m_last_child.resize(n);
+        m_next_sibling.resize(n);
+        m_child_count.resize(n);
+        m_subtree_size.resize(n);
+        m_depth.resize(n);
+    }
+
+    std::vector<std::uint32_t> m_name;
+    std::vector<NodeId> m_parent;
+    std::vector<NodeId> m_first_child;
+    std::vector<NodeId> m_last_child;
+    std::vector<NodeId> m_next_sibling;
+    std::vector<std::uint32_t> m_child_count;
+    std::vector<std::uint32_t> m_subtree_size;
+    std::vector<std::uint32_t> m_depth;
+    std::vector<NodeId> m_last_path; // 先序有效时：根到最后一个节点的路径，下标即深度
+    bool m_dfs_ordered{true};
+
+    std::deque<std::string> m_names;
+    std::unordered_map<std::string_view, std::uint32_t> m_name_ids;
+};
+
+inline void iterator_flat_test()
+{
+    FlatScene scene;
+    const auto player = scene.add_child(scene.root(), "Player");
+    scene.add_child(player, "Camera");
+    const auto enemy = scene.add_child(scene.root(), "Enemy");
+    scene.add_child(enemy, "Weapon");
+    const auto light = scene.add_child(scene.root(), "Light");
+    std::printf("ordered=%d:", scene.dfs_ordered());
+    scene.for_each_preorder(scene.root(), [&scene](FlatScene::NodeId n) { std::printf(" %s", scene.name(n).c_str()); });
+
+    scene.add_child(enemy, "HealthBar"); // 不在先序末尾：退回按链接遍历
+    scene.add_child(light, "Weapon");    // 同名，只存一份
+    std::printf("\nordered=%d:", scene.dfs_ordered());
+    scene.for_each_preorder(scene.root(), [&scene](FlatScene::NodeId n) { std::printf(" %s", scene.name(n).c_str()); });
+
+    const auto remap = scene.compact();
+    std::printf("\nordered=%d:", scene.dfs_ordered());
+    scene.for_each_preorder(scene.root(), [&scene](FlatScene::NodeId n) { std::printf(" %s", scene.name(n).c_str()); });
+    const auto enemy_now = remap[enemy];
+    std::printf("\nEnemy has %zu children, child_at(1)=%s, subtree=%zu, same name id: %d\n",
+                scene.child_count(enemy_now), scene.name(scene.child_at(enemy_now, 1)).c_str(),
+                scene.subtree_size(enemy_now),
+                scene.name_id(scene.child_at(enemy_now, 0)) == scene.name_id(scene.child_at(remap[light], 0)));
+}
+
+// 基准：node_count 个节点的两种树，计算所有节点深度之和
+//   随机树：平均深度约 25；深链：每个节点只有一个子节点，深度等于节点数
+//   指针树：显式栈保存 (节点, 深度)，每个节点一次 shared_ptr 链接的跳转
+//   FlatScene：先序线性扫描，depth[n] = depth[parent[n]] + 1
+inline void iterator_flat_benchmark(std::size_t node_count = 1000000, int rounds = 10)
+{
+    using Clock = std::chrono::steady_clock;
+    static const char *kNames[] = {"Mesh", "Light", "Camera", "Collider", "Weapon", "Sprite"};
+    auto ms = [](Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); };
+
+    auto run = [&](const char *label, SceneNode &root)
+    {
+        auto t0 = Clock::now();
+        FlatScene scene = FlatScene::from_tree(root);
+        auto t1 = Clock::now();
+
+        std::size_t pointer_sum = 0;
+        auto t2 = Clock::now();
+        for (int r = 0; r < rounds; ++r)
+        {
+            pointer_sum = 0;
+            std::vector<std::pair<SceneNode *, std::size_t>> stack{{&root, 0}};
+            while (!stack.empty())
+            {
+                const auto [node, depth] = stack.back();
+                stack.pop_back();
+                pointer_sum += depth;
+                for (std::size_t i = node->child_count(); i-- > 0;)
+                {
+                    stack.push_back({node->child_node(i), depth + 1});
+                }
+            }
+        }
+        auto t3 = Clock::now();
+
+        std::size_t flat_sum = 0;
+        std::vector<std::uint32_t> depth(scene.size());
+        for (int r = 0; r < rounds; ++r)
+        {
+            flat_sum = 0;
+            depth[0] = 0;
+            for (FlatScene::NodeId n = 1; n < scene.size(); ++n)
+            {
+                depth[n] = depth[scene.parent(n)] + 1;
+                flat_sum += depth[n];
+            }
+        }
+        auto t4 = Clock::now();
+
+        std::printf("[Bench] %s, %zu nodes (%s), flatten %.1f ms\n", label, scene.size(),
+                    pointer_sum == flat_sum && scene.subtree_size(scene.root()) == scene.size() ? "match" : "MISMATCH",
+                    ms(t1 - t0));
+        std::printf("  pointer tree : %8.2f ms/pass\n", ms(t3 - t2) / rounds);
+        std::printf("  FlatScene    : %8.2f ms/pass\n", ms(t4 - t3) / rounds);
+    };
+
+    {
+        auto root = std::make_shared<SceneNode>("Root");
+        std::vector<SceneNode *> parents{root.get()};
+        for (std::size_t i = 1; i < node_count; ++i)
+        {
+            auto node = std::make_shared<SceneNode>(kNames[i % 6]);
+            parents[((i * 2654435761u) >> 12) % parents.size()]->add_child(node);
+            parents.push_back(node.get());
+        }
+        run("random tree", *root);
+    }
+    {
+        auto root = std::make_shared<SceneNode>("Root");
+        SceneNode *tail = root.get();
+        for (std::size_t i = 1; i < node_count; ++i)
+        {
+            auto node = std::make_shared<SceneNode>(kNames[i % 6]);
+            tail->add_child(node);
+            tail = node.get();
+        }
+        run("deep chain ", *root);
+        // 逐层摘下再释放：直接析构会沿 shared_ptr 递归 node_count 层，爆栈
+        for (std::shared_ptr<SceneNode> node = root; node && node->child_count() > 0;)
+        {
+            node = node->remove_child(0);
+        }
+    }
+}
@@ -0,0 +1,326 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "iterator_tree.h"
+
+// SceneIndex：按完整路径（"Root/Enemy/Weapon"）或名字查找节点，平均 O(路径长度)，与树的大小无关
+// - 路径哈希逐段链式计算：hash(子) = segment_hash(子名, hash(父))，子树挂上时由父节点的哈希推出，不必重新哈希整条路径
+// - 作为 SceneObserver 挂在根上：add_child / remove_child 只更新变动的那棵子树
+// - 查找接受 string_view，按 '/' 就地切分，不分配内存
+// - 命中后比对末段名字与父路径哈希：末段精确，前缀靠 64 位哈希区分（误判概率约 2^-64），
+//   不必沿父链接逐个访问祖先节点（那是每层一次缓存未命中）
+// - 同一路径（兄弟节点同名）或同一名字有多个节点时，find / find_by_name 返回其中任意一个
+class SceneIndex final : public SceneObserver
+{
+public:
+    // root 必须是整棵树的根；索引存在期间 root 不能被析构
+    explicit SceneIndex(SceneNode &root) : m_root(root)
+    {
+        const auto count = static_cast<std::size_t>(std::distance(preorder(root).begin(), preorder(root).end()));
+        m_paths.reserve(count);
+        m_names.reserve(count);
+        on_attach(root);
+        root.set_observer(this);
+    }
+
+    ~SceneIndex() override { m_root.set_observer(nullptr); }
+
+    SceneIndex(const SceneIndex &) = delete;
+    SceneIndex &operator=(const SceneIndex &) = delete;
+
+    std::size_t size() const { return m_paths.size(); }
+
+    SceneNode *find(std::string_view path) const
+    {
+        std::uint64_t parent_hash = 0;
+        std::uint64_t hash = kRootSeed;
+        std::string_view last;
+        for (std::size_t begin = 0;;)
+        {
+            const std::size_t slash = path.find('/', begin);
+            last = path.substr(begin, slash - begin);
+            parent_hash = hash;
+            hash = segment_hash(last, hash);
+            if (slash == std::string_view::npos) break;
+            begin = slash + 1;
+        }
+        auto [first, end] = m_paths.equal_range(hash);
+        for (; first != end; ++first)
+        {
+            const Entry &entry = first->second;
+            if (entry.parent_hash == parent_hash && entry.node->name() == last)
+            {
+                return entry.node;
+            }
+        }
+        return nullptr;
+    }
+
+    SceneNode *find_by_name(std::string_view name) const
+    {
+        SceneNode *found = nullptr;
+        for_each_named(name, [&found](SceneNode &node) { found = &node; });
+        return found;
+    }
+
+    // 对每个名为 name 的节点调用 fn(SceneNode&)
+    template <typename Fn>
+    void for_each_named(std::string_view name, Fn &&fn) const
+    {
+        auto [first, end] = m_names.equal_range(segment_hash(name, 0));
+        for (; first != end; ++first)
+        {
+            if (first->second->name() == name)
+            {
+                fn(*first->second);
+            }
+        }
+    }
+
+    void on_attach(SceneNode &subtree) override
+    {
+        visit_subtree(subtree, [this](SceneNode &node, std::uint64_t parent_hash, std::uint64_t hash)
+                      {
+                          m_paths.emplace(hash, Entry{&node, parent_hash});
+                          m_names.emplace(segment_hash(node.name(), 0), &node);
+                      });
+    }
+
+    void on_detach(SceneNode &subtree) override
+    {
+        visit_subtree(subtree, [this](SceneNode &node, std::uint64_t, std::uint64_t hash)
+                      {
+                          erase_entry(m_paths, hash, &node);
+                          erase_entry(m_names, segment_hash(node.name(), 0), &node);
+                      });
+    }
+
+private:
+    struct Entry
+    {
+        SceneNode *node;
+        std::uint64_t parent_hash;
+    };
+
+    static constexpr std::uint64_t kRootSeed = 0x5CE7E1D3A11F00D5ull;
+
+    // 路径段很短（通常一两个机器字），逐字乘法混合；content_hash 的四路初始化对这种长度反而更慢
+    static std::uint64_t segment_hash(std::string_view segment, std::uint64_t seed)
+    {
+        constexpr std::uint64_t kMul = 0x9E3779B97F4A7C15ull;
+        const char *p = segment.data();
+        std::size_t n = segment.size();
+        std::uint64_t h = seed ^ (n * kMul);
+        while (n >= 8)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, p, 8);
+            h = (h ^ word) * kMul;
+            h ^= h >> 29;
+            p += 8;
+            n -= 8;
+        }
+        if (n > 0)
+        {
+            std::uint64_t word = 0;
+            std::memcpy(&word, p, n);
+            h = (h ^ word) * kMul;
+            h ^= h >> 29;
+        }
+        h *= 0xC2B2AE3D27D4EB4Full;
+        return h ^ (h >> 32);
+    }
+
+    // 从根算到 node 的路径哈希，O(深度)；只在子树挂上/摘下时用一次
+    std::uint64_t path_hash(const SceneNode *node) const
+    {
+        std::vector<const SceneNode *> chain;
+        for (; node; node = node->parent())
+        {
+            chain.push_back(node);
+        }
+        std::uint64_t hash = kRootSeed;
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+        {
+            hash = segment_hash((*it)->name(), hash);
+        }
+        return hash;
+    }
+
+    // 先序遍历子树，fn(节点, 父路径哈希, 路径哈希)
+    template <typename Fn>
+    void visit_subtree(SceneNode &subtree, Fn &&fn) const
+    {
+        std::vector<std::pair<SceneNode *, std::uint64_t>> stack{{&subtree, path_hash(subtree.parent())}};
+        while (!stack.empty())
+        {
+            const auto [node, parent_hash] = stack.back();
+            stack.pop_back();
+            const std::uint64_t hash = segment_hash(node->name(), parent_hash);
+            fn(*node, parent_hash, hash);
+            for (std::size_t i = 0; i < node->child_count(); ++i)
+            {
+                stack.push_back({node->child_node(i), hash});
+            }
+        }
+    }
+
+    template <typename Table>
+    static void erase_entry(Table &table, std::uint64_t hash, const SceneNode *node)
+    {
+        auto [first, end] = table.equal_range(hash);
+        for (; first != end; ++first)
+        {
+            if (entry_node(first->second) == node)
+            {
+                table.erase(first);
+                return;
+            }
+        }
+    }
+
+    static const SceneNode *entry_node(const Entry &entry) { return entry.node; }
+    static const SceneNode *entry_node(const SceneNode *node) { return node; }
+
+    SceneNode &m_root;
+    std::unordered_multimap<std::uint64_t, Entry> m_paths;       // 路径哈希 -> 节点
+    std::unordered_multimap<std::uint64_t, SceneNode *> m_names; // 名字哈希 -> 节点
+};
+
+inline void iterator_index_test()
+{
+    auto root = std::make_shared<SceneNode>("Root");
+    auto player = std::make_shared<SceneNode>("Player");
+    auto enemy = std::make_shared<SceneNode>("Enemy");
+    root->add_child(player);
+    root->add_child(enemy);
+    enemy->add_child(std::make_shared<SceneNode>("Weapon"));
+
+    SceneIndex index(*root);
+    player->add_child(std::make_shared<SceneNode>("Camera")); // 建索引之后的增删会自动同步
+    auto show = [&index](std::string_view path)
+    {
+        SceneNode *node = index.find(path);
+        std::printf("  %-28.*s -> %s\n", static_cast<int>(path.size()), path.data(),
+                    node ? node->name().c_str() : "(none)");
+    };
+    std::printf("indexed %zu nodes\n", index.size());
+    show("Root/Enemy/Weapon");
+    show("Root/Player/Camera");
+    show("Enemy/Weapon"); // 必须从根开始
+
+    auto moved = root->remove_child(1); // 摘下 Enemy 整棵子树
+    player->add_child(moved);           // 挂到 Player 下
+    std::printf("after moving Enemy under Player (%zu nodes):\n", index.size());
+    show("Root/Enemy/Weapon");
+    show("Root/Player/Enemy/Weapon");
+    SceneNode *weapon = index.find_by_name("Weapon");
+    std::printf("  find_by_name(Weapon) -> parent %s\n", weapon ? weapon->parent()->name().c_str() : "(none)");
+
+    // 不先 remove_child，直接挂到新父节点下：自动从 Player 摘下
+    root->add_child(moved);
+    std::printf("after re-parenting Enemy directly under Root (%zu nodes, Player has %zu children):\n",
+                index.size(), player->child_count());
+    show("Root/Enemy/Weapon");
+    show("Root/Player/Enemy/Weapon");
+
+    // 子节点比父节点活得久：父节点析构时清掉父链接
+    auto orphan = std::make_shared<SceneNode>("Orphan");
+    {
+        auto temp = std::make_shared<SceneNode>("Temp");
+        temp->add_child(orphan);
+    }
+    std::printf("  orphan parent after Temp destroyed: %s\n", orphan->parent() ? "dangling" : "none");
+}
+
+// 基准：node_count 个节点的随机树（名字各不相同），随机取 lookups 条完整路径
+//   逐层查找：按 '/' 切分，每层用 child_node 扫描子节点比对名字
+//   SceneIndex：逐段哈希 + 一次哈希表查找
+inline void iterator_index_benchmark(std::size_t node_count = 1000000, std::size_t lookups = 200000)
+{
+    using Clock = std::chrono::steady_clock;
+    auto root = std::make_shared<SceneNode>("Root");
+    std::vector<SceneNode *> nodes{root.get()};
+    for (std::size_t i = 1; i < node_count; ++i)
+    {
+        auto node = std::make_shared<SceneNode>("Node" + std::to_string(i));
+        nodes[((i * 2654435761u) >> 12) % nodes.size()]->add_child(node);
+        nodes.push_back(node.get());
+    }
+
+    std::vector<std::string> paths;
+    paths.reserve(lookups);
+    for (std::size_t i = 0; i < lookups; ++i)
+    {
+        std::string path;
+        for (SceneNode *node = nodes[(i * 2654435761u + 12345) % nodes.size()]; node; node = node->parent())
+        {
+            path.insert(0, node->parent() ? "/" + node->name() : node->name());
+        }
+        paths.push_back(std::move(path));
+    }
+
+    auto walk = [&root](std::string_view path) -> SceneNode *
+    {
+        SceneNode *node = nullptr;
+        for (std::size_t begin = 0;;)
+        {
+            const std::size_t slash = path.find('/', begin);
+            const std::string_view segment = path.substr(begin, slash - begin);
+            if (!node)
+            {
+                node = root->name() == segment ? root.get() : nullptr;
+            }
+            else
+            {
+                SceneNode *next = nullptr;
+                for (std::size_t c = 0; c < node->child_count() && !next; ++c)
+                {
+                    next = node->child_node(c)->name() == segment ? node->child_node(c) : nullptr;
+                }
+                node = next;
+            }
+            if (!node || slash == std::string_view::npos) return node;
+            begin = slash + 1;
+        }
+    };
+
+    auto t0 = Clock::now();
+    SceneIndex index(*root);
+    auto t1 = Clock::now();
+    std::size_t walk_hits = 0;
+    for (const auto &path : paths) walk_hits += walk(path) != nullptr;
+    auto t2 = Clock::now();
+    std::size_t index_hits = 0;
+    for (const auto &path : paths) index_hits += index.find(path) != nullptr;
+    auto t3 = Clock::now();
+
+    // 增量维护：在随机节点下生成再销毁一个叶子（常见的 spawn/despawn）
+    const std::size_t spawns = 100000;
+    auto t4 = Clock::now();
+    for (std::size_t i = 0; i < spawns; ++i)
+    {
+        SceneNode *parent = nodes[(i * 40503u) % nodes.size()];
+        parent->add_child(std::make_shared<SceneNode>("Spawned"));
+        parent->remove_child(parent->child_count() - 1);
+    }
+    auto t5 = Clock::now();
+
+    auto ns = [](Clock::duration d, std::size_t n) { return std::chrono::duration<double, std::nano>(d).count() / n; };
+    auto ms = [](Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); };
+    std::printf("[Bench] %zu nodes, %zu path lookups (%s), index build %.0f ms\n", node_count, lookups,
+                walk_hits == lookups && index_hits == lookups ? "all found" : "MISSING", ms(t1 - t0));
+    std::printf("  walk by child scan: %8.1f ns/lookup\n", ns(t2 - t1, lookups));
+    std::printf("  SceneIndex::find  : %8.1f ns/lookup\n", ns(t3 - t2, lookups));
+    std::printf("  spawn + despawn a leaf: %8.1f ns (index size %zu)\n", ns(t5 - t4, spawns), index.size());
+}
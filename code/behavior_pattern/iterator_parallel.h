@@ -0,0 +1,279 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "iterator_tree.h"
+
+// 并行子树遍历：对每个节点调用 fn(SceneNode&)，用上所有核
+// - 每个工作线程在本地栈上做先序遍历；本地积压超过 grain 个节点且自己的公开队列为空时，
+//   把栈底（离根最近、通常最大的子树）一半挪到公开队列，供别的线程窃取
+// - 自己从公开队列尾部取（LIFO，缓存友好）；窃取者一次加锁从头部拿走一半（FIFO，拿走大块），
+//   放进自己的本地栈，减少窃取次数和锁竞争
+// - 本地栈用 deque：栈顶在尾部，公开时从头部切走一半，代价只和切走的节点数成正比
+// - 父先于子：节点的子节点只有在 fn(父) 返回之后才入栈/入队，
+//   所以 fn 里可以读父节点已经算好的结果（如世界矩阵）
+// - fn 会在多个线程上并发调用，但同一时刻不会有两个线程处理同一个节点
+// SceneNode 不记录子树大小，切分依据是本地积压的节点数（惰性切分），不需要预先统计整棵树
+struct ParallelTraversalOptions
+{
+    std::size_t threads{std::max(1u, std::thread::hardware_concurrency())};
+    std::size_t grain{256}; // 本地积压超过这么多节点才对外公开
+};
+
+namespace scene_detail
+{
+struct alignas(64) StealQueue
+{
+    std::mutex mutex;
+    std::deque<SceneNode *> tasks;
+    std::atomic<std::size_t> size{0};
+
+    template <typename It>
+    void push_many(It first, It last)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.insert(tasks.end(), first, last);
+        size.store(tasks.size(), std::memory_order_relaxed);
+    }
+
+    SceneNode *pop_back()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tasks.empty()) return nullptr;
+        SceneNode *node = tasks.back();
+        tasks.pop_back();
+        size.store(tasks.size(), std::memory_order_relaxed);
+        return node;
+    }
+
+    // 从头部拿走一半（至少一个）追加到 out 尾部，返回拿走的个数
+    std::size_t steal_half(std::deque<SceneNode *> &out)
+    {
+        if (size.load(std::memory_order_relaxed) == 0) return 0; // 先看一眼，空队列不加锁
+        std::lock_guard<std::mutex> lock(mutex);
+        const std::size_t count = (tasks.size() + 1) / 2;
+        const auto last = tasks.begin() + static_cast<std::ptrdiff_t>(count);
+        out.insert(out.end(), tasks.begin(), last);
+        tasks.erase(tasks.begin(), last);
+        size.store(tasks.size(), std::memory_order_relaxed);
+        return count;
+    }
+};
+} // namespace scene_detail
+
+template <typename Fn>
+void parallel_preorder(SceneNode &root, Fn &&fn, const ParallelTraversalOptions &options = {})
+{
+    const std::size_t threads = std::max<std::size_t>(1, options.threads);
+    if (threads == 1)
+    {
+        for (SceneNode &node : preorder(root))
+        {
+            fn(node);
+        }
+        return;
+    }
+
+    std::vector<scene_detail::StealQueue> queues(threads);
+    std::atomic<std::size_t> outstanding{1}; // 尚未做完的任务（公开队列里的 + 正在处理的）
+    SceneNode *const start = &root;
+    queues[0].push_many(&start, &start + 1);
+
+    auto worker = [&](std::size_t self)
+    {
+        std::deque<SceneNode *> local;
+        // 处理本地栈直到清空；owned 是放进来的任务数（自己取的 1 个，或偷来的一批）
+        auto run_tasks = [&](std::size_t owned)
+        {
+            while (!local.empty())
+            {
+                SceneNode *node = local.back();
+                local.pop_back();
+                fn(*node);
+                for (std::size_t i = node->child_count(); i-- > 0;)
+                {
+                    local.push_back(node->child_node(i));
+                }
+                if (local.size() > options.grain && queues[self].size.load(std::memory_order_relaxed) == 0)
+                {
+                    const auto half = local.begin() + static_cast<std::ptrdiff_t>(local.size() / 2);
+                    outstanding.fetch_add(local.size() / 2, std::memory_order_relaxed);
+                    queues[self].push_many(local.begin(), half);
+                    local.erase(local.begin(), half);
+                }
+            }
+            outstanding.fetch_sub(owned, std::memory_order_acq_rel);
+        };
+
+        std::size_t victim = self;
+        while (outstanding.load(std::memory_order_acquire) > 0)
+        {
+            if (SceneNode *task = queues[self].pop_back())
+            {
+                local.push_back(task);
+                run_tasks(1);
+                continue;
+            }
+            std::size_t stolen = 0;
+            for (std::size_t i = 1; stolen == 0 && i < threads; ++i)
+            {
+                victim = (victim + 1) % threads;
+                if (victim != self)
+                {
+                    stolen = queues[victim].steal_half(local);
+                }
+            }
+            if (stolen > 0)
+            {
+                run_tasks(stolen);
+            }
+            else
+            {
+                std::this_thread::yield(); // 暂时无事可做，但别的线程可能还会公开新任务
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (std::size_t t = 1; t < threads; ++t)
+    {
+        workers.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto &thread : workers)
+    {
+        thread.join();
+    }
+}
+
+inline void iterator_parallel_test()
+{
+    auto root = std::make_shared<SceneNode>("Root");
+    std::vector<std::shared_ptr<SceneNode>> nodes{root};
+    for (std::size_t i = 1; i < 20000; ++i)
+    {
+        auto node = std::make_shared<SceneNode>("Node");
+        nodes[((i * 2654435761u) >> 12) % nodes.size()]->add_child(node);
+        nodes.push_back(node);
+    }
+
+    // 记录每个节点被处理的序号，检查父节点都先于子节点；map 预先建好，并发只写已有元素
+    std::unordered_map<const SceneNode *, std::size_t> order;
+    for (auto &node : nodes) order[node.get()] = 0;
+    std::atomic<std::size_t> counter{0};
+    ParallelTraversalOptions options;
+    options.threads = 4;
+    options.grain = 16;
+    parallel_preorder(*root, [&](SceneNode &node) { order.find(&node)->second = ++counter; }, options);
+
+    std::size_t violations = 0;
+    for (auto &node : nodes)
+    {
+        for (std::size_t i = 0; i < node->child_count(); ++i)
+        {
+            violations += order[node->child_node(i)] < order[node.get()];
+        }
+    }
+    std::printf("[ParallelTraversal] visited %zu of %zu nodes, parent-after-child violations: %zu\n",
+                counter.load(), nodes.size(), violations);
+}
+
+// 基准：两种形状的树，每个节点做一段固定计算，对比 1~16 个线程
+//   深而不平衡：一条长主干，每层挂一棵大小随机的侧枝
+//   宽而浅：根下直接挂大量叶子
+inline void iterator_parallel_benchmark(std::size_t node_count = 1000000, int work = 200)
+{
+    using Clock = std::chrono::steady_clock;
+    auto make_deep = [node_count]
+    {
+        // 主干 4000 层；每层挂一棵大小在 1~500 之间随机的侧枝，负载分布很不均匀
+        auto root = std::make_shared<SceneNode>("Root");
+        SceneNode *spine = root.get();
+        std::size_t made = 1;
+        for (std::size_t level = 0; made < node_count; ++level)
+        {
+            std::size_t branch = 1 + ((level * 2654435761u) >> 8) % 500;
+            branch = std::min(branch, node_count - made);
+            std::vector<SceneNode *> side;
+            for (std::size_t i = 0; i < branch; ++i)
+            {
+                auto node = std::make_shared<SceneNode>("Branch");
+                (side.empty() ? spine : side[((i * 40503u) >> 4) % side.size()])->add_child(node);
+                side.push_back(node.get());
+            }
+            made += branch;
+            if (made < node_count)
+            {
+                auto next = std::make_shared<SceneNode>("Spine");
+                spine->add_child(next);
+                spine = next.get();
+                ++made;
+            }
+        }
+        return root;
+    };
+    auto make_wide = [node_count]
+    {
+        auto root = std::make_shared<SceneNode>("Root");
+        for (std::size_t i = 1; i < node_count; ++i)
+        {
+            root->add_child(std::make_shared<SceneNode>("Leaf"));
+        }
+        return root;
+    };
+
+    // 分片累加，避免所有线程争用同一个原子变量
+    struct alignas(64) Slot
+    {
+        std::atomic<std::uint64_t> value{0};
+    };
+    static Slot slots[64];
+    static std::atomic<std::size_t> next_slot{0};
+    auto per_node = [work](SceneNode &node)
+    {
+        thread_local const std::size_t slot = next_slot.fetch_add(1) % 64;
+        std::uint64_t h = reinterpret_cast<std::uintptr_t>(&node);
+        for (int i = 0; i < work; ++i)
+        {
+            h = h * 6364136223846793005ull + 1442695040888963407ull; // 模拟变换更新的计算量
+        }
+        slots[slot].value.fetch_add(h & 0xff, std::memory_order_relaxed);
+    };
+    auto checksum = []
+    {
+        std::uint64_t sum = 0;
+        for (auto &slot : slots) sum += slot.value.exchange(0);
+        return sum;
+    };
+
+    std::printf("[Bench] %zu nodes, %d mixing steps per node, %u hardware threads\n", node_count, work,
+                std::thread::hardware_concurrency());
+    const std::pair<const char *, std::shared_ptr<SceneNode>> trees[] = {{"deep unbalanced", make_deep()},
+                                                                         {"wide shallow", make_wide()}};
+    for (const auto &tree : trees)
+    {
+        checksum();
+        for (SceneNode &node : preorder(*tree.second)) per_node(node);
+        const std::uint64_t expected = checksum();
+        for (std::size_t threads : {1, 2, 4, 8, 16})
+        {
+            ParallelTraversalOptions options;
+            options.threads = threads;
+            auto start = Clock::now();
+            parallel_preorder(*tree.second, per_node, options);
+            const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            std::printf("  %-15s %2zu threads: %8.2f ms %s\n", tree.first, threads, ms,
+                        checksum() == expected ? "match" : "MISMATCH");
+        }
+    }
+}
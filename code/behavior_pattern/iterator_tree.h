@@ -0,0 +1,292 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include "iterator.h"
+
+// 整棵子树的标准前向迭代器：先序 / 后序深度优先、广度优先
+// - 解引用得到 SceneNode&，遍历过程不复制 shared_ptr，没有引用计数的原子操作
+// - 用显式栈/队列代替递归，深层树不会爆栈；栈/队列是迭代器自己的 vector，
+//   只在变深/变宽时扩容，之后每一步都复用同一块存储（先序栈的大小约为 深度 × 分支数）
+// - 迭代器可复制，副本各自独立前进（满足前向迭代器的多遍保证），可用于 range-for 和 <algorithm>
+// - 遍历期间不要修改树的结构
+namespace scene_detail
+{
+struct Frame
+{
+    SceneNode *node;
+    std::size_t next_child; // 下一个要进入的子节点下标
+};
+} // namespace scene_detail
+
+// 先序：父节点先于子节点，子节点按 add_child 的顺序
+// 栈里放“待访问的节点”：弹出当前节点后把它的子节点逆序压栈，栈顶即下一个节点
+class PreorderIterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = SceneNode;
+    using difference_type = std::ptrdiff_t;
+    using pointer = SceneNode *;
+    using reference = SceneNode &;
+
+    PreorderIterator() = default;
+    explicit PreorderIterator(SceneNode &root) : m_current(&root) { m_stack.push_back(&root); }
+
+    reference operator*() const { return *m_current; }
+    pointer operator->() const { return m_current; }
+
+    PreorderIterator &operator++()
+    {
+        SceneNode *node = m_stack.back();
+        m_stack.pop_back();
+        for (std::size_t i = node->child_count(); i-- > 0;)
+        {
+            m_stack.push_back(node->child_node(i));
+        }
+        m_current = m_stack.empty() ? nullptr : m_stack.back();
+        return *this;
+    }
+
+    PreorderIterator operator++(int)
+    {
+        PreorderIterator old = *this;
+        ++*this;
+        return old;
+    }
+
+    // 树中每个节点只出现一次，当前节点即可代表位置；结束时为 nullptr
+    friend bool operator==(const PreorderIterator &a, const PreorderIterator &b) { return a.m_current == b.m_current; }
+    friend bool operator!=(const PreorderIterator &a, const PreorderIterator &b) { return !(a == b); }
+
+private:
+    SceneNode *m_current{nullptr};
+    std::vector<SceneNode *> m_stack;
+};
+
+// 后序：子节点先于父节点，起点最后出现
+class PostorderIterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = SceneNode;
+    using difference_type = std::ptrdiff_t;
+    using pointer = SceneNode *;
+    using reference = SceneNode &;
+
+    PostorderIterator() = default;
+    explicit PostorderIterator(SceneNode &root) { descend(&root); }
+
+    reference operator*() const { return *m_stack.back().node; }
+    pointer operator->() const { return m_stack.back().node; }
+
+    PostorderIterator &operator++()
+    {
+        m_stack.pop_back();
+        if (!m_stack.empty())
+        {
+            scene_detail::Frame &parent = m_stack.back();
+            if (SceneNode *sibling = parent.node->child_node(parent.next_child))
+            {
+                ++parent.next_child;
+                descend(sibling); // 下一个兄弟子树的最左叶子
+            }
+        }
+        return *this;
+    }
+
+    PostorderIterator operator++(int)
+    {
+        PostorderIterator old = *this;
+        ++*this;
+        return old;
+    }
+
+    friend bool operator==(const PostorderIterator &a, const PostorderIterator &b) { return a.current() == b.current(); }
+    friend bool operator!=(const PostorderIterator &a, const PostorderIterator &b) { return !(a == b); }
+
+private:
+    SceneNode *current() const { return m_stack.empty() ? nullptr : m_stack.back().node; }
+
+    void descend(SceneNode *node)
+    {
+        for (;;)
+        {
+            SceneNode *first = node->child_node(0);
+            m_stack.push_back({node, first ? 1u : 0u});
+            if (!first)
+            {
+                return;
+            }
+            node = first;
+        }
+    }
+
+    std::vector<scene_detail::Frame> m_stack;
+};
+
+// 广度优先：按层从上到下。队列是 vector + 队头下标，队头过半时整体前移，不反复分配
+class BreadthFirstIterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = SceneNode;
+    using difference_type = std::ptrdiff_t;
+    using pointer = SceneNode *;
+    using reference = SceneNode &;
+
+    BreadthFirstIterator() = default;
+    explicit BreadthFirstIterator(SceneNode &root) { m_queue.push_back(&root); }
+
+    reference operator*() const { return *m_queue[m_head]; }
+    pointer operator->() const { return m_queue[m_head]; }
+
+    BreadthFirstIterator &operator++()
+    {
+        SceneNode *node = m_queue[m_head++];
+        for (std::size_t i = 0; i < node->child_count(); ++i)
+        {
+            m_queue.push_back(node->child_node(i));
+        }
+        if (m_head == m_queue.size())
+        {
+            m_queue.clear();
+            m_head = 0;
+        }
+        else if (m_head * 2 >= m_queue.size())
+        {
+            m_queue.erase(m_queue.begin(), m_queue.begin() + static_cast<std::ptrdiff_t>(m_head));
+            m_head = 0;
+        }
+        return *this;
+    }
+
+    BreadthFirstIterator operator++(int)
+    {
+        BreadthFirstIterator old = *this;
+        ++*this;
+        return old;
+    }
+
+    friend bool operator==(const BreadthFirstIterator &a, const BreadthFirstIterator &b) { return a.current() == b.current(); }
+    friend bool operator!=(const BreadthFirstIterator &a, const BreadthFirstIterator &b) { return !(a == b); }
+
+private:
+    SceneNode *current() const { return m_head < m_queue.size() ? m_queue[m_head] : nullptr; }
+
+    std::vector<SceneNode *> m_queue;
+    std::size_t m_head{0};
+};
+
+// begin/end 对，供 range-for 与 <algorithm> 使用
+template <typename Iterator>
+class SceneRange
+{
+public:
+    explicit SceneRange(SceneNode &root) : m_root(root) {}
+
+    Iterator begin() const { return Iterator(m_root); }
+    Iterator end() const { return Iterator(); }
+
+private:
+    SceneNode &m_root;
+};
+
+inline SceneRange<PreorderIterator> preorder(SceneNode &root) { return SceneRange<PreorderIterator>(root); }
+inline SceneRange<PostorderIterator> postorder(SceneNode &root) { return SceneRange<PostorderIterator>(root); }
+inline SceneRange<BreadthFirstIterator> breadth_first(SceneNode &root) { return SceneRange<BreadthFirstIterator>(root); }
+
+inline void iterator_tree_test()
+{
+    auto root = std::make_shared<SceneNode>("Root");
+    auto player = std::make_shared<SceneNode>("Player");
+    auto enemy = std::make_shared<SceneNode>("Enemy");
+    player->add_child(std::make_shared<SceneNode>("Camera"));
+    enemy->add_child(std::make_shared<SceneNode>("Weapon"));
+    enemy->add_child(std::make_shared<SceneNode>("HealthBar"));
+    root->add_child(player);
+    root->add_child(enemy);
+    root->add_child(std::make_shared<SceneNode>("Light"));
+
+    std::printf("preorder:");
+    for (SceneNode &node : preorder(*root))
+    {
+        std::printf(" %s", node.name().c_str());
+    }
+    std::printf("\npostorder:");
+    for (SceneNode &node : postorder(*root))
+    {
+        std::printf(" %s", node.name().c_str());
+    }
+    std::printf("\nbreadth-first:");
+    for (SceneNode &node : breadth_first(*root))
+    {
+        std::printf(" %s", node.name().c_str());
+    }
+
+    auto range = preorder(*root);
+    auto weapon = std::find_if(range.begin(), range.end(),
+                               [](const SceneNode &node) { return node.name() == "Weapon"; });
+    const auto leaves = std::count_if(range.begin(), range.end(),
+                                      [](const SceneNode &node) { return node.child_count() == 0; });
+    std::printf("\nfound %s, %td leaves, %td nodes\n", weapon != range.end() ? weapon->name().c_str() : "nothing",
+                leaves, std::distance(range.begin(), range.end()));
+}
+
+namespace scene_detail
+{
+// 基准的参照组：普通递归 + child_at，统计整棵树的名字字节数
+inline std::size_t name_bytes_recursive(const SceneNode &node)
+{
+    std::size_t total = node.name().size();
+    for (std::size_t i = 0; i < node.child_count(); ++i)
+    {
+        total += name_bytes_recursive(*node.child_at(i));
+    }
+    return total;
+}
+} // namespace scene_detail
+
+// 基准：node_count 个节点的随机树，递归 + child_at（每步复制 shared_ptr）与先序迭代器对比
+// 注意：libstdc++ 只在程序链接了线程库时才对引用计数使用原子操作
+inline void iterator_tree_benchmark(std::size_t node_count = 1000000, int rounds = 10)
+{
+    using Clock = std::chrono::steady_clock;
+    auto root = std::make_shared<SceneNode>("Root");
+    std::vector<SceneNode *> parents{root.get()};
+    for (std::size_t i = 1; i < node_count; ++i)
+    {
+        auto node = std::make_shared<SceneNode>("Node");
+        parents[((i * 2654435761u) >> 12) % parents.size()]->add_child(node); // 伪随机挂到已有节点下
+        parents.push_back(node.get());
+    }
+
+    std::size_t by_recursion = 0;
+    auto t0 = Clock::now();
+    for (int r = 0; r < rounds; ++r)
+    {
+        by_recursion = scene_detail::name_bytes_recursive(*root);
+    }
+    auto t1 = Clock::now();
+    std::size_t by_iterator = 0;
+    for (int r = 0; r < rounds; ++r)
+    {
+        by_iterator = 0;
+        for (SceneNode &node : preorder(*root))
+        {
+            by_iterator += node.name().size();
+        }
+    }
+    auto t2 = Clock::now();
+
+    auto ms = [rounds](Clock::duration d)
+    { return std::chrono::duration<double, std::milli>(d).count() / rounds; };
+    std::printf("[Bench] %zu nodes (%s)\n", node_count, by_recursion == by_iterator ? "match" : "MISMATCH");
+    std::printf("  recursion + child_at: %8.2f ms/pass\n", ms(t1 - t0));
+    std::printf("  preorder iterator   : %8.2f ms/pass\n", ms(t2 - t1));
+}
@@ -5,6 +5,8 @@
 #include <string>
 #include <vector>
 
+#include "../utility/trace.h"
+
 class Player; // 前向声明，供接口签名使用
 
 // 中介者接口：定义同事交互的统一入口
@@ -36,8 +38,7 @@ public:
 
     void receive(const std::string& from, const std::string& message)
     {
-        std::printf("[%s -> %s] %s\n", from.c_str(), m_name.c_str(),
-                    message.c_str());
+        TRACE_DEBUG("[{} -> {}] {}", from, m_name, message);
         m_last_message = message;
     }
 
@@ -115,4 +116,5 @@ inline void mediator_test()
     alice->send("Hello everyone!");
     mediator->remove_player("Bob");
     carol->send("Bob has left, right?");
+    trace::flush();
 }
@@ -1,8 +1,9 @@
 #pragma once
+#include <cstdint>
 #include <iostream>
 #include <memory>
-#include <stack>
 #include <utility>
+#include <vector>
 
 class SaveHistory; // 前向声明
 
@@ -35,7 +36,8 @@ public:
         int m_health;
         std::pair<int, int> m_pos;
 
-        friend class Player; // 仅 Player 可构造/读取
+        friend class Player;        // 仅 Player 可构造/读取
+        friend struct MementoCodec; // 存档编解码（见 memento_persist.h）
     };
 
 private:
@@ -52,7 +54,8 @@ public:
     {
         if (!memento) return;
         std::puts("[History] save snapshot.");
-        m_history.push(std::move(memento));
+        m_history.push_back(std::move(memento));
+        m_sequence.push_back(m_next_sequence++);
     }
 
     std::shared_ptr<Player::PlayerMemento> undo()
@@ -62,14 +65,52 @@ public:
             std::puts("[History] nothing to undo.");
             return nullptr;
         }
-        auto top = m_history.top();
-        m_history.pop();
+        auto top = std::move(m_history.back());
+        m_history.pop_back();
+        m_sequence.pop_back();
         std::puts("[History] undo snapshot.");
         return top;
     }
 
+    std::size_t size() const { return m_history.size(); }
+
+    // 第 i 个快照的序号：每次 save 分配一个新序号，从不复用
+    // 下标 i 处的序号没变，说明 [0, i] 这段历史都没变（只能在栈顶增删），增量存档靠它判断
+    std::uint64_t sequence(std::size_t i) const { return m_sequence[i]; }
+
+    // 按保存顺序（旧 → 新）遍历快照，只交出不透明的快照指针
+    template <typename Func>
+    void for_each(Func &&func) const
+    {
+        for_each_from(0, std::forward<Func>(func));
+    }
+
+    // 从第 first 个快照开始遍历
+    template <typename Func>
+    void for_each_from(std::size_t first, Func &&func) const
+    {
+        for (std::size_t i = first; i < m_history.size(); ++i)
+        {
+            func(*m_history[i]);
+        }
+    }
+
+    // 整体替换历史（读档时使用），不逐条打印日志
+    void replace(std::vector<std::shared_ptr<Player::PlayerMemento>> history)
+    {
+        m_history = std::move(history);
+        m_sequence.resize(m_history.size());
+        for (auto &sequence : m_sequence)
+        {
+            sequence = m_next_sequence++;
+        }
+    }
+
 private:
-    std::stack<std::shared_ptr<Player::PlayerMemento>> m_history;
+    // vector 当栈使用：back 为栈顶，同时支持顺序遍历
+    std::vector<std::shared_ptr<Player::PlayerMemento>> m_history;
+    std::vector<std::uint64_t> m_sequence; // 与 m_history 一一对应
+    std::uint64_t m_next_sequence{0};
 };
 
 // Player 与 SaveHistory 成员函数定义
@@ -0,0 +1,332 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "memento.h"
+#include "../utility/mapped_file.h"
+
+// 存档文件布局（小端、定长、无需解析）：
+//   SaveFileHeader | SaveRecord[count]
+// 各字段逐字节按小端写入/读出，与主机字节序无关；读档时直接在映射内存上按定长记录取值，不走文本解析
+struct SaveFileHeader
+{
+    char magic[4];       // "SAVE"
+    std::uint32_t version;
+    std::uint32_t count; // 记录条数
+    std::uint32_t reserved;
+};
+
+struct SaveRecord
+{
+    std::int32_t health;
+    std::int32_t x;
+    std::int32_t y;
+};
+
+static_assert(sizeof(SaveFileHeader) == 16, "header layout must be stable");
+static_assert(sizeof(SaveRecord) == 12, "record layout must be stable");
+
+constexpr std::uint32_t kSaveFileVersion = 1;
+
+// MementoCodec：PlayerMemento 的友元，负责快照 <-> 二进制记录
+// Caretaker 依旧不解析快照内容，编解码只在这里发生
+struct MementoCodec
+{
+    // 小端读写：在小端主机上编译器会合并成一次 4 字节访问
+    static void store_le32(char *out, std::uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            out[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+        }
+    }
+
+    static std::uint32_t load_le32(const char *in)
+    {
+        std::uint32_t value = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            value |= std::uint32_t(static_cast<unsigned char>(in[i])) << (8 * i);
+        }
+        return value;
+    }
+
+    static void encode_header(std::uint32_t count, char *out)
+    {
+        std::memcpy(out, "SAVE", 4);
+        store_le32(out + 4, kSaveFileVersion);
+        store_le32(out + 8, count);
+        store_le32(out + 12, 0);
+    }
+
+    static void encode_record(const Player::PlayerMemento &memento, char *out)
+    {
+        store_le32(out, static_cast<std::uint32_t>(memento.m_health));
+        store_le32(out + 4, static_cast<std::uint32_t>(memento.m_pos.first));
+        store_le32(out + 8, static_cast<std::uint32_t>(memento.m_pos.second));
+    }
+
+    // 把第 first 个起的快照追加编码到 out 末尾（只是定长拷贝）
+    static void encode_from(const SaveHistory &history, std::size_t first, std::vector<char> &out)
+    {
+        std::size_t offset = out.size();
+        out.resize(offset + sizeof(SaveRecord) * (history.size() - first));
+        history.for_each_from(first, [&](const Player::PlayerMemento &memento)
+        {
+            encode_record(memento, out.data() + offset);
+            offset += sizeof(SaveRecord);
+        });
+    }
+
+    // 直接从映射内存恢复历史，失败时不改动 history
+    static bool decode(const char *data, std::size_t size, SaveHistory &history)
+    {
+        if (!data || size < sizeof(SaveFileHeader))
+        {
+            return false;
+        }
+        const std::uint32_t count = load_le32(data + 8);
+        if (std::memcmp(data, "SAVE", 4) != 0
+            || load_le32(data + 4) != kSaveFileVersion
+            || (size - sizeof(SaveFileHeader)) / sizeof(SaveRecord) < count)
+        {
+            return false;
+        }
+
+        std::vector<std::shared_ptr<Player::PlayerMemento>> snapshots;
+        snapshots.reserve(count);
+        const char *record = data + sizeof(SaveFileHeader);
+        for (std::uint32_t i = 0; i < count; ++i, record += sizeof(SaveRecord))
+        {
+            snapshots.emplace_back(new Player::PlayerMemento(
+                static_cast<std::int32_t>(load_le32(record)),
+                {static_cast<std::int32_t>(load_le32(record + 4)), static_cast<std::int32_t>(load_le32(record + 8))}));
+        }
+        history.replace(std::move(snapshots));
+        return true;
+    }
+};
+
+// AsyncSaveWriter：后台落盘，tick 线程永不等待磁盘
+// - 增量投递：tick 线程只编码上次投递之后变化的快照，投递的是“截断到 keep 条 + 追加这些记录”
+//   （历史只在栈顶增删，用 SaveHistory::sequence 找出仍然有效的前缀），每次 submit 的开销与变化量成正比
+// - 工作线程维护完整的记录镜像，取走投递的增量应用上去再写盘；写盘期间不持锁
+// - 若上一份尚未写出就来了新的，两份增量合并成一份（只写最新存档）
+class AsyncSaveWriter
+{
+public:
+    explicit AsyncSaveWriter(std::string path)
+    : m_path(std::move(path))
+    , m_worker([this] { run(); })
+    {}
+
+    ~AsyncSaveWriter()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_cv.notify_one();
+        m_worker.join(); // 退出前把最后一份存档写完
+    }
+
+    AsyncSaveWriter(const AsyncSaveWriter &) = delete;
+    AsyncSaveWriter &operator=(const AsyncSaveWriter &) = delete;
+
+    // tick 线程调用：同一个 writer 只能跟踪同一份 history
+    void submit(const SaveHistory &history)
+    {
+        // 上次投递的序号从尾部往回对，第一个仍然相同的位置之前都不用重新编码
+        std::size_t keep = std::min(m_sent.size(), history.size());
+        while (keep > 0 && history.sequence(keep - 1) != m_sent[keep - 1])
+        {
+            --keep;
+        }
+        m_sent.resize(keep);
+        for (std::size_t i = keep; i < history.size(); ++i)
+        {
+            m_sent.push_back(history.sequence(i));
+        }
+        m_delta.clear();
+        MementoCodec::encode_from(history, keep, m_delta);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_has_pending)
+            {
+                m_pending_keep = keep;
+                m_pending.swap(m_delta);
+            }
+            else
+            {
+                // 合并：先前的增量把镜像变成 m_pending_keep + m_pending 条，再截断到 keep 条并追加
+                const std::size_t pending_records = m_pending.size() / sizeof(SaveRecord);
+                if (keep >= m_pending_keep)
+                {
+                    const std::size_t kept = std::min(keep - m_pending_keep, pending_records);
+                    m_pending.resize(kept * sizeof(SaveRecord));
+                    m_pending.insert(m_pending.end(), m_delta.begin(), m_delta.end());
+                }
+                else
+                {
+                    m_pending_keep = keep;
+                    m_pending.swap(m_delta);
+                }
+            }
+            m_has_pending = true;
+        }
+        m_cv.notify_one();
+    }
+
+    // 等待当前已投递的存档全部写完（测试/退出前使用）
+    void flush()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle_cv.wait(lock, [this] { return !m_has_pending && !m_writing; });
+    }
+
+    std::size_t written_count() const { return m_written.load(); }
+
+private:
+    void run()
+    {
+        std::vector<char> image(sizeof(SaveFileHeader)); // 工作线程独占：头 + 全部记录
+        std::vector<char> delta;
+        for (;;)
+        {
+            std::size_t keep = 0;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait(lock, [this] { return m_stop || m_has_pending; });
+                if (!m_has_pending)
+                {
+                    return; // m_stop 且无待写数据
+                }
+                delta.swap(m_pending);
+                m_pending.clear();
+                keep = m_pending_keep;
+                m_has_pending = false;
+                m_writing = true;
+            }
+
+            image.resize(sizeof(SaveFileHeader) + keep * sizeof(SaveRecord));
+            image.insert(image.end(), delta.begin(), delta.end());
+            MementoCodec::encode_header(
+                static_cast<std::uint32_t>((image.size() - sizeof(SaveFileHeader)) / sizeof(SaveRecord)),
+                image.data());
+            write_file(image);
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_writing = false;
+            }
+            m_idle_cv.notify_all();
+        }
+    }
+
+    // 先写临时文件再替换，崩溃时不会留下半截存档：
+    // 替换是原子的，任何时刻磁盘上要么是旧存档，要么是新存档
+    void write_file(const std::vector<char> &buffer)
+    {
+        const std::string tmp = m_path + ".tmp";
+        std::FILE *fp = std::fopen(tmp.c_str(), "wb");
+        if (!fp)
+        {
+            std::puts("[SaveWriter] open failed.");
+            return;
+        }
+        const bool ok =
+            std::fwrite(buffer.data(), 1, buffer.size(), fp) == buffer.size();
+        std::fclose(fp);
+        if (!ok)
+        {
+            std::puts("[SaveWriter] write failed.");
+            std::remove(tmp.c_str());
+            return;
+        }
+#ifdef _WIN32
+        // Windows 下 rename 不覆盖已有文件，用 MoveFileEx 原子替换
+        const bool replaced = ::MoveFileExA(tmp.c_str(), m_path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+        const bool replaced = std::rename(tmp.c_str(), m_path.c_str()) == 0; // POSIX rename 本身就会原子替换
+#endif
+        if (!replaced)
+        {
+            std::puts("[SaveWriter] rename failed.");
+            return;
+        }
+        ++m_written;
+    }
+
+    std::string m_path;
+    std::vector<std::uint64_t> m_sent; // tick 线程独占：已投递的各快照序号
+    std::vector<char> m_delta;         // tick 线程独占：本次编码的记录
+    std::vector<char> m_pending;       // 投递槽（待追加的记录），受 m_mutex 保护
+    std::size_t m_pending_keep{0};     // 追加之前镜像保留的记录数
+    bool m_has_pending{false};
+    bool m_writing{false};
+    bool m_stop{false};
+    std::atomic<std::size_t> m_written{0};
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::condition_variable m_idle_cv;
+    std::thread m_worker; // 最后声明：保证其余成员先于线程构造完成
+};
+
+// 读档：映射文件并直接恢复到 history
+inline bool load_save_file(const std::string &path, SaveHistory &history)
+{
+    MappedFile file;
+    if (!file.open(path))
+    {
+        std::puts("[SaveLoader] open failed.");
+        return false;
+    }
+    if (!MementoCodec::decode(file.data(), file.size(), history))
+    {
+        std::puts("[SaveLoader] bad save file.");
+        return false;
+    }
+    return true;
+}
+
+// 演示：tick 中投递存档，退出后读档并回滚
+inline void memento_persist_test()
+{
+    const std::string path = "memento_save.bin";
+    {
+        auto history = std::make_shared<SaveHistory>();
+        Player player(100, {0, 0}, history);
+        AsyncSaveWriter writer(path);
+
+        for (int tick = 0; tick < 3; ++tick)
+        {
+            player.move(1, 2);
+            player.damage(10);
+            player.save();
+            writer.submit(*history); // 不阻塞 tick
+        }
+        writer.flush();
+        player.print_state();
+    }
+
+    auto loaded = std::make_shared<SaveHistory>();
+    if (load_save_file(path, *loaded))
+    {
+        Player player(0, {0, 0}, loaded);
+        player.restore(); // 回到最后一次存档
+        player.print_state();
+    }
+    std::remove(path.c_str());
+}
@@ -0,0 +1,282 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// PersistentVector：32 叉 trie + 路径复制的持久化数组
+// - 拷贝句柄 O(1)：只复制 root 指针，所有节点共享
+// - set/push_back 只复制根到叶的一条路径（log32 N 个节点），其余结构共享
+// - 节点未被共享（use_count()==1）时原地修改，不做无谓复制
+// 注意：use_count 判断仅在单线程修改时成立，跨线程共享快照需改为总是复制
+template <typename T>
+class PersistentVector
+{
+    static constexpr unsigned kBits = 5;
+    static constexpr std::size_t kWidth = std::size_t(1) << kBits;
+    static constexpr std::size_t kMask = kWidth - 1;
+
+    struct Leaf
+    {
+        std::array<T, kWidth> values{};
+    };
+
+    struct Branch
+    {
+        // 子节点类型由所在层决定：shift == kBits 时为 Leaf，否则为 Branch
+        std::array<std::shared_ptr<void>, kWidth> children{};
+    };
+
+public:
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    const T &operator[](std::size_t idx) const
+    {
+        const void *node = m_root.get();
+        for (unsigned shift = m_shift; shift > 0; shift -= kBits)
+        {
+            node = static_cast<const Branch *>(node)
+                       ->children[(idx >> shift) & kMask].get();
+        }
+        return static_cast<const Leaf *>(node)->values[idx & kMask];
+    }
+
+    void set(std::size_t idx, T value)
+    {
+        m_root = assoc(m_root, m_shift, idx, std::move(value));
+    }
+
+    void push_back(T value)
+    {
+        if (!m_root)
+        {
+            m_root = std::make_shared<Leaf>();
+        }
+        else if (m_size == (std::size_t(1) << (m_shift + kBits)))
+        {
+            // 容量已满：加一层新根，旧根成为第 0 个孩子
+            auto root = std::make_shared<Branch>();
+            root->children[0] = std::move(m_root);
+            m_root = std::move(root);
+            m_shift += kBits;
+        }
+        m_root = assoc(m_root, m_shift, m_size, std::move(value));
+        ++m_size;
+    }
+
+    // 统计从本句柄可达、且尚未在 seen 中出现的节点字节数（用于比较内存占用）
+    template <typename Set>
+    std::size_t unique_bytes(Set &seen) const
+    {
+        return count_bytes(m_root.get(), m_shift, seen);
+    }
+
+private:
+    static std::shared_ptr<void> assoc(const std::shared_ptr<void> &node,
+                                       unsigned shift, std::size_t idx,
+                                       T value)
+    {
+        if (shift == 0)
+        {
+            std::shared_ptr<Leaf> leaf;
+            if (node && node.use_count() == 1)
+            {
+                leaf = std::static_pointer_cast<Leaf>(node); // 独占：原地改
+            }
+            else
+            {
+                leaf = node ? std::make_shared<Leaf>(
+                                  *std::static_pointer_cast<Leaf>(node))
+                            : std::make_shared<Leaf>();
+            }
+            leaf->values[idx & kMask] = std::move(value);
+            return leaf;
+        }
+
+        std::shared_ptr<Branch> branch;
+        if (node && node.use_count() == 1)
+        {
+            branch = std::static_pointer_cast<Branch>(node);
+        }
+        else
+        {
+            branch = node ? std::make_shared<Branch>(
+                                *std::static_pointer_cast<Branch>(node))
+                          : std::make_shared<Branch>();
+        }
+        auto &slot = branch->children[(idx >> shift) & kMask];
+        // 先释放本层对子节点的额外引用，子节点独占时才能原地修改
+        auto child = std::move(slot);
+        slot = assoc(child, shift - kBits, idx, std::move(value));
+        return branch;
+    }
+
+    template <typename Set>
+    static std::size_t count_bytes(const void *node, unsigned shift, Set &seen)
+    {
+        if (!node || !seen.insert(node).second)
+        {
+            return 0;
+        }
+        if (shift == 0)
+        {
+            return sizeof(Leaf);
+        }
+        std::size_t bytes = sizeof(Branch);
+        for (const auto &child : static_cast<const Branch *>(node)->children)
+        {
+            bytes += count_bytes(child.get(), shift - kBits, seen);
+        }
+        return bytes;
+    }
+
+    std::shared_ptr<void> m_root;
+    std::size_t m_size{0};
+    unsigned m_shift{0};
+};
+
+class WorldHistory; // 前向声明
+
+// Originator：大型世界状态（地块数据），快照只复制持久化数组句柄
+class WorldState
+{
+public:
+    explicit WorldState(std::size_t tile_count)
+    {
+        for (std::size_t i = 0; i < tile_count; ++i)
+        {
+            m_tiles.push_back(0);
+        }
+    }
+
+    void paint(std::size_t idx, int value) { m_tiles.set(idx, value); }
+    int tile(std::size_t idx) const { return m_tiles[idx]; }
+    std::size_t tile_count() const { return m_tiles.size(); }
+
+    // 备忘录：只持有共享结构的根，O(1) 生成
+    class WorldMemento
+    {
+    private:
+        explicit WorldMemento(PersistentVector<int> tiles)
+        : m_tiles(std::move(tiles)) {}
+
+        PersistentVector<int> m_tiles;
+
+        friend class WorldState;
+        friend class WorldHistory;
+    };
+
+    WorldMemento save() const { return WorldMemento(m_tiles); }
+    void restore(const WorldMemento &memento) { m_tiles = memento.m_tiles; }
+
+private:
+    PersistentVector<int> m_tiles;
+};
+
+// Caretaker：可廉价保存成千上万份快照
+class WorldHistory
+{
+public:
+    void save(WorldState::WorldMemento memento)
+    {
+        m_history.push_back(std::move(memento));
+    }
+
+    bool undo(WorldState &world)
+    {
+        if (m_history.empty())
+        {
+            return false;
+        }
+        world.restore(m_history.back());
+        m_history.pop_back();
+        return true;
+    }
+
+    std::size_t size() const { return m_history.size(); }
+
+    // 所有快照实际占用的节点字节数（共享节点只计一次）
+    template <typename Set>
+    std::size_t shared_bytes(Set &seen) const
+    {
+        std::size_t bytes = 0;
+        for (const auto &memento : m_history)
+        {
+            bytes += memento.m_tiles.unique_bytes(seen);
+        }
+        return bytes;
+    }
+
+private:
+    std::vector<WorldState::WorldMemento> m_history;
+};
+
+// 演示：O(1) 快照与回滚
+inline void memento_persistent_test()
+{
+    WorldState world(100);
+    WorldHistory history;
+
+    world.paint(3, 7);
+    history.save(world.save());
+
+    world.paint(3, 9);
+    world.paint(42, 1);
+    std::printf("[World] tile3=%d tile42=%d\n", world.tile(3), world.tile(42));
+
+    history.undo(world);
+    std::printf("[World] tile3=%d tile42=%d\n", world.tile(3), world.tile(42));
+}
+
+// 基准：每帧改少量地块并存一份快照，比较整份拷贝与结构共享
+inline void memento_persistent_benchmark()
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr std::size_t kTiles = 1 << 16;
+    constexpr int kSnapshots = 1000;
+    constexpr int kEditsPerFrame = 8;
+
+    // 整份拷贝版本
+    std::vector<int> flat(kTiles, 0);
+    std::vector<std::vector<int>> flat_history;
+    auto t0 = Clock::now();
+    for (int frame = 0; frame < kSnapshots; ++frame)
+    {
+        for (int e = 0; e < kEditsPerFrame; ++e)
+        {
+            flat[(frame * 7919u + e * 104729u) % kTiles] = frame;
+        }
+        flat_history.push_back(flat);
+    }
+    auto t1 = Clock::now();
+
+    // 持久化版本
+    WorldState world(kTiles);
+    WorldHistory history;
+    auto t2 = Clock::now();
+    for (int frame = 0; frame < kSnapshots; ++frame)
+    {
+        for (int e = 0; e < kEditsPerFrame; ++e)
+        {
+            world.paint((frame * 7919u + e * 104729u) % kTiles, frame);
+        }
+        history.save(world.save());
+    }
+    auto t3 = Clock::now();
+
+    std::unordered_set<const void *> seen;
+    const double flat_mb =
+        double(kTiles * sizeof(int)) * kSnapshots / (1024.0 * 1024.0);
+    const double shared_mb = double(history.shared_bytes(seen)) / (1024.0 * 1024.0);
+    auto ms = [](Clock::duration d)
+    { return std::chrono::duration<double, std::milli>(d).count(); };
+
+    std::printf("[Bench] %d snapshots of %zu tiles\n", kSnapshots, kTiles);
+    std::printf("  full copy : %8.2f ms, %8.2f MB\n", ms(t1 - t0), flat_mb);
+    std::printf("  persistent: %8.2f ms, %8.2f MB\n", ms(t3 - t2), shared_mb);
+}
@@ -4,6 +4,8 @@
 #include<memory>
 #include<list>
 
+#include "../utility/trace.h"
+
 //事件结构体
 struct Event
 {
@@ -48,7 +50,7 @@ public:
             ++m_defeat_num;
             if (m_defeat_num % 5 == 0)
             {
-                std::puts("task finished!");
+                TRACE_DEBUG("task finished!");
             }
         }
     }
@@ -68,7 +70,7 @@ public:
             ++m_rare_items_num;
             if (m_rare_items_num % 3 == 0)
             {
-                std::puts("nice collected!");
+                TRACE_DEBUG("nice collected!");
             }
         }
     }
@@ -83,7 +85,7 @@ public:
     using Observers::Observers;
     void monitor(const Event &event) override
     {
-        std::printf("type:%s,payload:%s\n", event.type_.c_str(), event.payload_.c_str());
+        TRACE_DEBUG("type:{},payload:{}", event.type_, event.payload_);
     }
 };
 
@@ -168,4 +170,5 @@ void observer_test()
     ebus.broadcast(rit);
     ebus.broadcast(rit);
     ebus.broadcast(rand);
+    trace::flush();
 }
\ No newline at end of file
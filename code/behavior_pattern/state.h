@@ -1,8 +1,13 @@
 #pragma once
 #include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <vector>
+
+#include "../utility/trace.h"
 
 #if 1 //将状态写死在playercontext版本
 enum class Input
@@ -10,7 +15,8 @@ enum class Input
     None,
     Move,
     Stop,
-    Attack
+    Attack,
+    Count // 输入种类数（哨兵，不是真实输入）；按输入建表的代码用它定大小
 };
 
 class PlayerContext;
@@ -48,8 +54,7 @@ public:
     void enter(PlayerContext &context) override;
     void handle_input(PlayerContext &context, Input input) override;
     void update(PlayerContext &context) override;
-private:
-    int m_frames_left{0};
+
     static constexpr int kTotalFrames{3};
 };
 
@@ -60,7 +65,7 @@ public:
 
     void change_state(const std::shared_ptr<IState> &state)
     {
-        if (m_state == state || !state)
+        if (m_state == state.get() || !state)
         {
             return;
         }
@@ -68,7 +73,7 @@ public:
         {
             m_state->exit(*this);
         }
-        m_state = state;
+        m_state = state.get();
         m_state->enter(*this);
     }
 
@@ -91,7 +96,7 @@ public:
     void play_animation(const std::string &name)
     {
         m_current_animation = name;
-        std::cout << "[Animation] -> " << m_current_animation << '\n';
+        TRACE_DEBUG("[Animation] -> {}", m_current_animation);
     }
 
     bool has_stamina(int cost) const
@@ -102,34 +107,36 @@ public:
     void consume_stamina(int cost)
     {
         m_stamina = std::max(0, m_stamina - cost);
-        std::cout << "[Stamina] now " << m_stamina << '\n';
+        TRACE_DEBUG("[Stamina] now {}", m_stamina);
     }
 
     void restore_stamina(int amount)
     {
         m_stamina = std::min(100, m_stamina + amount);
-        std::cout << "[Stamina] now " << m_stamina << '\n';
+        TRACE_DEBUG("[Stamina] now {}", m_stamina);
     }
 
-    std::shared_ptr<IState> idle_state() const { return m_idle_state; }
-    std::shared_ptr<IState> running_state() const { return m_running_state; }
-    std::shared_ptr<IState> attack_state() const { return m_attack_state; }
+    // 状态对象无状态，全进程共享一份；实体数据都放在 context 里
+    static const std::shared_ptr<IState> &idle_state();
+    static const std::shared_ptr<IState> &running_state();
+    static const std::shared_ptr<IState> &attack_state();
+
+    int attack_frames_left() const { return m_attack_frames_left; }
+    void set_attack_frames_left(int frames) { m_attack_frames_left = frames; }
 
 private:
-    std::shared_ptr<IState> m_state;
-    std::shared_ptr<IState> m_idle_state;
-    std::shared_ptr<IState> m_running_state;
-    std::shared_ptr<IState> m_attack_state;
+    IState *m_state{nullptr}; // 指向共享状态对象，不持有所有权
 
     int m_health{100};
     int m_stamina{100};
+    int m_attack_frames_left{0}; // AttackState 的逐实体数据
     std::string m_current_animation{"idle"};
 };
 
 // ----- IdleState -----
 inline void IdleState::enter(PlayerContext &context)
 {
-    std::cout << "[State] Enter Idle\n";
+    TRACE_DEBUG("[State] Enter Idle");
     context.play_animation("Idle");
 }
 
@@ -153,7 +160,7 @@ inline void IdleState::update(PlayerContext &context)
 // ----- RunningState -----
 inline void RunningState::enter(PlayerContext &context)
 {
-    std::cout << "[State] Enter Running\n";
+    TRACE_DEBUG("[State] Enter Running");
     context.play_animation("Run");
 }
 
@@ -178,7 +185,7 @@ inline void RunningState::update(PlayerContext &context)
     }
     else
     {
-        std::cout << "[Running] Out of stamina -> Idle\n";
+        TRACE_DEBUG("[Running] Out of stamina -> Idle");
         context.change_state(context.idle_state());
     }
 }
@@ -186,42 +193,59 @@ inline void RunningState::update(PlayerContext &context)
 inline void RunningState::exit(PlayerContext &context)
 {
     (void)context;
-    std::cout << "[State] Exit Running\n";
+    TRACE_DEBUG("[State] Exit Running");
 }
 
 // ----- AttackState -----
 inline void AttackState::enter(PlayerContext &context)
 {
-    std::cout << "[State] Enter Attack\n";
+    TRACE_DEBUG("[State] Enter Attack");
     context.play_animation("Attack");
-    m_frames_left = kTotalFrames;
+    context.set_attack_frames_left(kTotalFrames);
 }
 
 inline void AttackState::handle_input(PlayerContext &context, Input input)
 {
     if (input == Input::Attack)
     {
-        std::cout << "[Attack] Combo input queued\n";
-        m_frames_left = kTotalFrames; // simple combo reset
+        TRACE_DEBUG("[Attack] Combo input queued");
+        context.set_attack_frames_left(kTotalFrames); // simple combo reset
     }
 }
 
 inline void AttackState::update(PlayerContext &context)
 {
-    if (--m_frames_left <= 0)
+    const int frames_left = context.attack_frames_left() - 1;
+    context.set_attack_frames_left(frames_left);
+    if (frames_left <= 0)
     {
-        std::cout << "[Attack] Animation finished -> Idle\n";
+        TRACE_DEBUG("[Attack] Animation finished -> Idle");
         context.change_state(context.idle_state());
     }
 }
 
-// ----- PlayerContext ctor -----
+// ----- PlayerContext shared states & ctor -----
+inline const std::shared_ptr<IState> &PlayerContext::idle_state()
+{
+    static const std::shared_ptr<IState> state = std::make_shared<IdleState>();
+    return state;
+}
+
+inline const std::shared_ptr<IState> &PlayerContext::running_state()
+{
+    static const std::shared_ptr<IState> state = std::make_shared<RunningState>();
+    return state;
+}
+
+inline const std::shared_ptr<IState> &PlayerContext::attack_state()
+{
+    static const std::shared_ptr<IState> state = std::make_shared<AttackState>();
+    return state;
+}
+
 inline PlayerContext::PlayerContext()
 {
-    m_idle_state = std::make_shared<IdleState>();
-    m_running_state = std::make_shared<RunningState>();
-    m_attack_state = std::make_shared<AttackState>();
-    change_state(m_idle_state);
+    change_state(idle_state());
 }
 
 // ----- test helper -----
@@ -244,5 +268,42 @@ inline void state_test()
     player.handle_input(Input::Move);
     player.handle_input(Input::Stop);
     player.update();
+    trace::flush();
+}
+
+// ----- benchmark helper -----
+// 各状态机基准共用的输入脚本：第 frame 帧给第 entity 个实体的输入
+inline Input scripted_input(std::size_t entity, int frame)
+{
+    switch ((entity + static_cast<std::size_t>(frame) * 3) % 8)
+    {
+    case 0: return Input::Move;
+    case 1: return Input::Attack;
+    case 3: return Input::Stop;
+    default: return Input::None;
+    }
+}
+
+// 基准的参照组：entity_count 个逐对象 PlayerContext 按脚本跑 frames 帧，返回耗时
+// PlayerContext 带 TRACE_DEBUG 日志，这里用运行期级别临时静音，只测状态机本身
+// （编译时定义 DP_TRACE_LEVEL=DP_TRACE_LEVEL_OFF 可彻底去掉追踪调用）
+inline std::chrono::steady_clock::duration time_per_object_states(std::size_t entity_count, int frames)
+{
+    using Clock = std::chrono::steady_clock;
+    const trace::Level saved = trace::runtime_level(); // 结束后恢复调用方的级别
+    trace::set_runtime_level(std::max(saved, trace::Level::Info));
+    std::vector<PlayerContext> objects(entity_count);
+    const auto t0 = Clock::now();
+    for (int f = 0; f < frames; ++f)
+    {
+        for (std::size_t i = 0; i < entity_count; ++i)
+        {
+            objects[i].handle_input(scripted_input(i, f));
+            objects[i].update();
+        }
+    }
+    const auto elapsed = Clock::now() - t0;
+    trace::set_runtime_level(saved);
+    return elapsed;
 }
 #endif
@@ -0,0 +1,222 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "state.h"
+
+// 面向数据的状态机：按“当前状态”把实体分组，每组用 SoA 数组存放
+// - update 对每组跑一个紧凑循环，没有虚调用、没有 shared_ptr
+// - 状态切换 = 把实体从一组挪到另一组（尾部交换删除，O(1)）
+// 行为与 state.h 中 Idle/Running/Attack 一致，只是不再打印日志
+enum class StateId : std::uint8_t
+{
+    Idle,
+    Running,
+    Attack,
+    Count
+};
+
+class PlayerCrowd
+{
+public:
+    static constexpr int kMaxStamina = 100;
+    static constexpr int kIdleRestore = 2;
+    static constexpr int kRunCost = 5;
+    static constexpr int kAttackFrames = 3;
+
+    void reserve(std::size_t count)
+    {
+        m_slots.reserve(count);
+        for (auto &group : m_groups)
+        {
+            group.ids.reserve(count);
+            group.stamina.reserve(count);
+            group.frames_left.reserve(count);
+        }
+    }
+
+    // 新实体进入 Idle，体力满
+    std::uint32_t spawn()
+    {
+        const auto id = static_cast<std::uint32_t>(m_slots.size());
+        m_slots.push_back({StateId::Idle, 0});
+        push(StateId::Idle, id, kMaxStamina, 0);
+        return id;
+    }
+
+    void handle_input(std::uint32_t id, Input input)
+    {
+        const Slot slot = m_slots[id];
+        switch (slot.state)
+        {
+        case StateId::Idle:
+            if (input == Input::Move) move_to(id, StateId::Running);
+            else if (input == Input::Attack) move_to(id, StateId::Attack);
+            break;
+        case StateId::Running:
+            if (input == Input::Stop) move_to(id, StateId::Idle);
+            else if (input == Input::Attack) move_to(id, StateId::Attack);
+            break;
+        case StateId::Attack:
+            if (input == Input::Attack)
+            {
+                group(StateId::Attack).frames_left[slot.index] = kAttackFrames;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    // 一帧：Idle 先更新（它不会切出），Running/Attack 只会切回 Idle，
+    // 所以切入 Idle 的实体本帧不会被重复更新
+    void update()
+    {
+        auto &idle = group(StateId::Idle);
+        for (auto &stamina : idle.stamina)
+        {
+            stamina = std::min(kMaxStamina, stamina + kIdleRestore);
+        }
+
+        auto &running = group(StateId::Running);
+        for (std::size_t i = running.ids.size(); i-- > 0;)
+        {
+            if (running.stamina[i] >= kRunCost)
+            {
+                running.stamina[i] -= kRunCost;
+            }
+            else
+            {
+                move_to(running.ids[i], StateId::Idle);
+            }
+        }
+
+        auto &attack = group(StateId::Attack);
+        for (std::size_t i = attack.ids.size(); i-- > 0;)
+        {
+            if (--attack.frames_left[i] <= 0)
+            {
+                move_to(attack.ids[i], StateId::Idle);
+            }
+        }
+    }
+
+    std::size_t size() const { return m_slots.size(); }
+    StateId state_of(std::uint32_t id) const { return m_slots[id].state; }
+    int stamina_of(std::uint32_t id) const
+    {
+        const Slot slot = m_slots[id];
+        return m_groups[static_cast<std::size_t>(slot.state)].stamina[slot.index];
+    }
+    std::size_t count(StateId state) const
+    {
+        return m_groups[static_cast<std::size_t>(state)].ids.size();
+    }
+
+private:
+    // 某个状态下所有实体的 SoA 数据
+    struct Group
+    {
+        std::vector<std::uint32_t> ids;
+        std::vector<int> stamina;
+        std::vector<int> frames_left;
+    };
+
+    // 实体 id -> 所在组与组内下标
+    struct Slot
+    {
+        StateId state;
+        std::uint32_t index;
+    };
+
+    Group &group(StateId state) { return m_groups[static_cast<std::size_t>(state)]; }
+
+    void push(StateId state, std::uint32_t id, int stamina, int frames_left)
+    {
+        auto &g = group(state);
+        m_slots[id] = {state, static_cast<std::uint32_t>(g.ids.size())};
+        g.ids.push_back(id);
+        g.stamina.push_back(stamina);
+        g.frames_left.push_back(frames_left);
+    }
+
+    // 切换状态：从旧组尾部交换删除，追加到新组（相当于 exit + enter）
+    void move_to(std::uint32_t id, StateId next)
+    {
+        const Slot slot = m_slots[id];
+        auto &from = group(slot.state);
+        const int stamina = from.stamina[slot.index];
+
+        const std::uint32_t last = static_cast<std::uint32_t>(from.ids.size() - 1);
+        if (slot.index != last)
+        {
+            from.ids[slot.index] = from.ids[last];
+            from.stamina[slot.index] = from.stamina[last];
+            from.frames_left[slot.index] = from.frames_left[last];
+            m_slots[from.ids[slot.index]].index = slot.index;
+        }
+        from.ids.pop_back();
+        from.stamina.pop_back();
+        from.frames_left.pop_back();
+
+        push(next, id, stamina, next == StateId::Attack ? kAttackFrames : 0);
+    }
+
+    Group m_groups[static_cast<std::size_t>(StateId::Count)];
+    std::vector<Slot> m_slots;
+};
+
+// 演示：与 state_test 相同的输入序列
+inline void state_dod_test()
+{
+    PlayerCrowd crowd;
+    const auto player = crowd.spawn();
+
+    crowd.handle_input(player, Input::Move);
+    for (int i = 0; i < 3; ++i)
+    {
+        crowd.update();
+    }
+    crowd.handle_input(player, Input::Attack);
+    for (int i = 0; i < 4; ++i)
+    {
+        crowd.update();
+    }
+    std::printf("[Crowd] state=%d stamina=%d\n",
+                static_cast<int>(crowd.state_of(player)),
+                crowd.stamina_of(player));
+}
+
+// 基准：同样的输入脚本驱动 N 个实体，比较每帧耗时
+inline void state_dod_benchmark(std::size_t entity_count = 200000,
+                                int frames = 100)
+{
+    using Clock = std::chrono::steady_clock;
+    const Clock::duration per_object = time_per_object_states(entity_count, frames);
+
+    PlayerCrowd crowd;
+    crowd.reserve(entity_count);
+    for (std::size_t i = 0; i < entity_count; ++i)
+    {
+        crowd.spawn();
+    }
+    auto t2 = Clock::now();
+    for (int f = 0; f < frames; ++f)
+    {
+        for (std::size_t i = 0; i < entity_count; ++i)
+        {
+            crowd.handle_input(static_cast<std::uint32_t>(i), scripted_input(i, f));
+        }
+        crowd.update();
+    }
+    auto t3 = Clock::now();
+
+    auto fps = [frames](Clock::duration d)
+    { return frames / std::chrono::duration<double>(d).count(); };
+    std::printf("[Bench] %zu entities, %d frames\n", entity_count, frames);
+    std::printf("  per-object : %10.1f frames/s\n", fps(per_object));
+    std::printf("  data-orient: %10.1f frames/s\n", fps(t3 - t2));
+}
@@ -0,0 +1,262 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+#include "state.h"
+
+// 编译期状态机：状态/输入/转移写成一张表，编译期展开成扁平数组
+// - 转移查表：kTable[state * 输入数 + input]，无 if/else 链
+// - enter/exit/update 钩子在编译期生成函数指针数组，无虚函数、无堆分配
+// - from == to 的行视为“内部转移”：只执行 action，不触发 exit/enter
+
+// 转移表中的一行
+template <typename Ctx, typename StateT, typename InputT>
+struct FsmRow
+{
+    StateT from;
+    InputT on;
+    StateT to;
+    void (*action)(Ctx &) = nullptr;
+};
+
+// Def 需要提供：
+//   using context_type / state_type / input_type;
+//   static constexpr std::size_t kStateCount, kInputCount;
+//   static constexpr state_type kInitial;
+//   static constexpr std::array<FsmRow<...>, N> kRows;
+//   template <state_type S> static void enter(context_type &);
+//   template <state_type S> static void exit(context_type &);
+//   template <state_type S> static state_type update(context_type &); // 返回下一状态
+template <typename Def>
+class StaticFsm
+{
+public:
+    using Ctx = typename Def::context_type;
+    using StateT = typename Def::state_type;
+    using InputT = typename Def::input_type;
+
+    static constexpr std::size_t kStates = Def::kStateCount;
+    static constexpr std::size_t kInputs = Def::kInputCount;
+
+    explicit StaticFsm(Ctx context = Ctx{})
+    : m_context(std::move(context))
+    , m_state(Def::kInitial)
+    {
+        kEnter[index(m_state)](m_context);
+    }
+
+    void handle_input(InputT input)
+    {
+        const Cell &cell = kTable[index(m_state) * kInputs + index(input)];
+        if (!cell.valid)
+        {
+            return;
+        }
+        if (cell.to == m_state)
+        {
+            if (cell.action) cell.action(m_context); // 内部转移
+            return;
+        }
+        kExit[index(m_state)](m_context);
+        if (cell.action) cell.action(m_context);
+        m_state = cell.to;
+        kEnter[index(m_state)](m_context);
+    }
+
+    void update()
+    {
+        const StateT next = kUpdate[index(m_state)](m_context);
+        if (next != m_state)
+        {
+            kExit[index(m_state)](m_context);
+            m_state = next;
+            kEnter[index(m_state)](m_context);
+        }
+    }
+
+    StateT state() const { return m_state; }
+    const Ctx &context() const { return m_context; }
+
+private:
+    struct Cell
+    {
+        StateT to{};
+        void (*action)(Ctx &){nullptr};
+        bool valid{false};
+    };
+
+    template <typename E>
+    static constexpr std::size_t index(E value)
+    {
+        return static_cast<std::size_t>(value);
+    }
+
+    static constexpr std::array<Cell, kStates * kInputs> build_table()
+    {
+        std::array<Cell, kStates * kInputs> table{};
+        for (const auto &row : Def::kRows)
+        {
+            table[index(row.from) * kInputs + index(row.on)] =
+                Cell{row.to, row.action, true};
+        }
+        return table;
+    }
+
+    template <std::size_t... Is>
+    static constexpr std::array<void (*)(Ctx &), kStates>
+    make_enter(std::index_sequence<Is...>)
+    {
+        return {{&Def::template enter<static_cast<StateT>(Is)>...}};
+    }
+
+    template <std::size_t... Is>
+    static constexpr std::array<void (*)(Ctx &), kStates>
+    make_exit(std::index_sequence<Is...>)
+    {
+        return {{&Def::template exit<static_cast<StateT>(Is)>...}};
+    }
+
+    template <std::size_t... Is>
+    static constexpr std::array<StateT (*)(Ctx &), kStates>
+    make_update(std::index_sequence<Is...>)
+    {
+        return {{&Def::template update<static_cast<StateT>(Is)>...}};
+    }
+
+    static constexpr auto kTable = build_table();
+    static constexpr auto kEnter = make_enter(std::make_index_sequence<kStates>{});
+    static constexpr auto kExit = make_exit(std::make_index_sequence<kStates>{});
+    static constexpr auto kUpdate = make_update(std::make_index_sequence<kStates>{});
+
+    Ctx m_context;
+    StateT m_state;
+};
+
+// ----- 用编译期状态机重写 Idle/Running/Attack 玩家 -----
+enum class FsmState
+{
+    Idle,
+    Running,
+    Attack,
+    Count
+};
+
+// 玩家数据直接放在上下文里，状态本身不持有任何数据
+struct FsmPlayer
+{
+    int stamina{100};
+    int frames_left{0};
+    const char *animation{"idle"};
+};
+
+struct PlayerFsmDef
+{
+    using context_type = FsmPlayer;
+    using state_type = FsmState;
+    using input_type = Input;
+    using Row = FsmRow<FsmPlayer, FsmState, Input>;
+
+    static constexpr std::size_t kStateCount = static_cast<std::size_t>(FsmState::Count);
+    static constexpr std::size_t kInputCount = static_cast<std::size_t>(Input::Count);
+    static constexpr FsmState kInitial = FsmState::Idle;
+
+    static constexpr int kRunCost = 5;
+    static constexpr int kAttackFrames = 3;
+
+    static void combo_reset(FsmPlayer &player) { player.frames_left = kAttackFrames; }
+
+    static constexpr std::array<Row, 5> kRows{{
+        {FsmState::Idle,    Input::Move,   FsmState::Running},
+        {FsmState::Idle,    Input::Attack, FsmState::Attack},
+        {FsmState::Running, Input::Stop,   FsmState::Idle},
+        {FsmState::Running, Input::Attack, FsmState::Attack},
+        {FsmState::Attack,  Input::Attack, FsmState::Attack, &combo_reset},
+    }};
+
+    template <FsmState S>
+    static void enter(FsmPlayer &player)
+    {
+        if constexpr (S == FsmState::Idle) player.animation = "Idle";
+        if constexpr (S == FsmState::Running) player.animation = "Run";
+        if constexpr (S == FsmState::Attack)
+        {
+            player.animation = "Attack";
+            player.frames_left = kAttackFrames;
+        }
+    }
+
+    template <FsmState S>
+    static void exit(FsmPlayer &) {}
+
+    template <FsmState S>
+    static FsmState update(FsmPlayer &player)
+    {
+        if constexpr (S == FsmState::Idle)
+        {
+            player.stamina = std::min(100, player.stamina + 2);
+        }
+        else if constexpr (S == FsmState::Running)
+        {
+            if (player.stamina < kRunCost) return FsmState::Idle;
+            player.stamina -= kRunCost;
+        }
+        else if constexpr (S == FsmState::Attack)
+        {
+            if (--player.frames_left <= 0) return FsmState::Idle;
+        }
+        return S;
+    }
+};
+
+using PlayerFsm = StaticFsm<PlayerFsmDef>;
+
+// 演示：与 state_test 相同的输入序列
+inline void state_fsm_test()
+{
+    PlayerFsm player;
+
+    player.handle_input(Input::Move);
+    for (int i = 0; i < 3; ++i)
+    {
+        player.update();
+    }
+    player.handle_input(Input::Attack);
+    for (int i = 0; i < 4; ++i)
+    {
+        player.update();
+    }
+    std::printf("[Fsm] state=%d stamina=%d anim=%s\n",
+                static_cast<int>(player.state()),
+                player.context().stamina, player.context().animation);
+}
+
+// 基准：逐实体驱动，比较虚函数状态对象与编译期转移表（输入脚本与参照组见 state.h）
+inline void state_fsm_benchmark(std::size_t entity_count = 200000,
+                                int frames = 100)
+{
+    using Clock = std::chrono::steady_clock;
+    const Clock::duration per_object = time_per_object_states(entity_count, frames);
+
+    std::vector<PlayerFsm> machines(entity_count);
+    auto t2 = Clock::now();
+    for (int f = 0; f < frames; ++f)
+    {
+        for (std::size_t i = 0; i < entity_count; ++i)
+        {
+            machines[i].handle_input(scripted_input(i, f));
+            machines[i].update();
+        }
+    }
+    auto t3 = Clock::now();
+
+    auto fps = [frames](Clock::duration d)
+    { return frames / std::chrono::duration<double>(d).count(); };
+    std::printf("[Bench] %zu entities, %d frames\n", entity_count, frames);
+    std::printf("  virtual state : %10.1f frames/s\n", fps(per_object));
+    std::printf("  static table  : %10.1f frames/s\n", fps(t3 - t2));
+}
@@ -0,0 +1,147 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <thread>
+
+#include "state.h"
+#include "../utility/mpsc_ring.h"
+
+// 合并一帧内的冗余输入，返回合并后的个数（原地改写）
+// - 丢弃 Input::None
+// - 连续重复的输入只保留一个：同一帧内没有 update 插在中间，
+//   第二次同样的输入要么无效，要么是幂等的（如 Attack 连击重置）
+// 不同输入之间不做抵消（Move 后 Stop 仍会触发 enter/exit 动画）
+inline std::size_t collapse_inputs(Input *inputs, std::size_t count)
+{
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (inputs[i] == Input::None)
+        {
+            continue;
+        }
+        if (kept > 0 && inputs[kept - 1] == inputs[i])
+        {
+            continue;
+        }
+        inputs[kept++] = inputs[i];
+    }
+    return kept;
+}
+
+// QueuedPlayerContext：输入先进环形缓冲，帧开始时在模拟线程批量处理
+// - post() 可由多个线程（输入、网络）同时调用，队列是多生产者环形缓冲；
+//   同一线程投递的输入保持先后顺序
+// - process_inputs() 在模拟线程每帧开头调用，状态切换不会发生在帧中间
+class QueuedPlayerContext
+{
+public:
+    static constexpr std::size_t kQueueSize = 64;
+
+    // 任意生产者线程：队列满时丢弃并计数，不阻塞输入线程
+    bool post(Input input)
+    {
+        if (!m_inputs.try_push(input))
+        {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    // 模拟线程：取走本帧所有输入，合并后依次执行，返回实际执行的个数
+    std::size_t process_inputs()
+    {
+        Input batch[kQueueSize];
+        const std::size_t count = m_inputs.pop_batch(batch, kQueueSize);
+        m_received += count;
+        const std::size_t kept = collapse_inputs(batch, count);
+        for (std::size_t i = 0; i < kept; ++i)
+        {
+            m_context.handle_input(batch[i]);
+        }
+        return kept;
+    }
+
+    void update() { m_context.update(); }
+
+    PlayerContext &context() { return m_context; }
+    std::size_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+    std::size_t received() const { return m_received; } // 模拟线程：累计取出（合并前）的输入数
+
+private:
+    PlayerContext m_context;
+    MpscRing<Input, kQueueSize> m_inputs;
+    std::size_t m_received{0};
+    std::atomic<std::size_t> m_dropped{0};
+};
+
+// 演示：输入线程连按攻击，模拟线程帧开始时一次性处理
+inline void state_input_test()
+{
+    QueuedPlayerContext player;
+
+    std::thread input_thread([&player]
+    {
+        player.post(Input::Move);
+        player.post(Input::Move);
+        player.post(Input::Attack);
+        player.post(Input::Attack);
+        player.post(Input::None);
+        player.post(Input::Attack);
+    });
+    input_thread.join();
+
+    const std::size_t executed = player.process_inputs();
+    TRACE_INFO("[Input] executed {} inputs after collapse", executed);
+    for (int i = 0; i < 4; ++i)
+    {
+        player.update();
+    }
+    trace::flush();
+
+    // 输入线程与网络线程同时投递，模拟线程同时逐帧处理：
+    // 每个输入要么被取出，要么因队列满被丢弃并计数，不会丢失或重复
+    // 状态切换会打大量 Debug 追踪，压力段先临时静音
+    const trace::Level saved_level = trace::runtime_level();
+    trace::set_runtime_level(std::max(saved_level, trace::Level::Warn));
+    QueuedPlayerContext shared;
+    constexpr std::size_t kPerProducer = 20000;
+    std::atomic<int> producers_left{2};
+    auto produce = [&](Input first, Input second)
+    {
+        for (std::size_t i = 0; i < kPerProducer; ++i)
+        {
+            shared.post(i % 2 ? first : second);
+            if (i % 16 == 15)
+            {
+                std::this_thread::yield(); // 模拟真实输入的节奏，别让生产者一直占满队列
+            }
+        }
+        producers_left.fetch_sub(1, std::memory_order_release);
+    };
+    std::thread keyboard(produce, Input::Move, Input::Stop);
+    std::thread network(produce, Input::Attack, Input::Stop);
+    std::size_t frames = 0;
+    while (producers_left.load(std::memory_order_acquire) > 0)
+    {
+        shared.process_inputs();
+        shared.update();
+        ++frames;
+        std::this_thread::yield(); // 一帧结束，让出时间片
+    }
+    keyboard.join();
+    network.join();
+    while (shared.process_inputs() > 0) // 取走生产者退出前留下的尾巴
+    {
+        shared.update();
+        ++frames;
+    }
+    trace::flush();
+    trace::set_runtime_level(saved_level);
+    std::printf("[Input] 2 producers posted %zu, received %zu + dropped %zu over %zu frames (%s)\n",
+                2 * kPerProducer, shared.received(), shared.dropped(), frames,
+                shared.received() + shared.dropped() == 2 * kPerProducer ? "balanced" : "LOST");
+}
@@ -2,30 +2,44 @@
 #include<iostream>
 #include<string>
 #include<memory>
+#include<chrono>
+#include<variant>
+#include<vector>
 
 //封装互换算法并通过统一接口切换的设计就符合策略模式
 class IWeaponStrategy
 {
 public:
+    virtual ~IWeaponStrategy() = default; //通过基类指针释放，必须有虚析构
     virtual void damage() const = 0;
+    virtual int compute_damage(int power) const = 0; //战斗结算用，不打印
 };
 
-class SwordStrategy : public IWeaponStrategy
+//final：在已知具体类型时编译器可以去虚化
+class SwordStrategy final : public IWeaponStrategy
 {
 public:
     void damage() const override
     {
         printf("damage 50!\n");
     }
+    int compute_damage(int power) const override
+    {
+        return 50 + power;
+    }
 };
 
-class MagicStrategy : public IWeaponStrategy
+class MagicStrategy final : public IWeaponStrategy
 {
 public:
     void damage() const override
     {
         printf("damage magic!\n");
     }
+    int compute_damage(int power) const override
+    {
+        return power * 2;
+    }
 };
 
 class Player 
@@ -53,10 +67,67 @@ public:
         }
         this->m_weapon->damage();
     }
+
+    int compute_attack(int power) const
+    {
+        return m_weapon ? m_weapon->compute_damage(power) : 0;
+    }
 private:
     std::shared_ptr<IWeaponStrategy> m_weapon;
 };
 
+//封闭集合版本：武器种类固定时用 variant 保存策略，std::visit 静态分派
+//仍然可以运行时 set_weapon 切换，但没有堆分配和虚调用
+using WeaponVariant = std::variant<std::monostate, SwordStrategy, MagicStrategy>;
+
+class VariantPlayer
+{
+public:
+    void set_weapon(WeaponVariant weapon)
+    {
+        if (weapon.index() != 0 && weapon.index() == m_weapon.index())
+        {
+            printf("you already have it!\n");
+            return;
+        }
+        m_weapon = std::move(weapon);
+    }
+
+    void attack() const
+    {
+        std::visit([](const auto &weapon)
+        {
+            using T = std::decay_t<decltype(weapon)>;
+            if constexpr (std::is_same_v<T, std::monostate>)
+            {
+                printf("where's your weapon?\n");
+            }
+            else
+            {
+                weapon.damage();
+            }
+        }, m_weapon);
+    }
+
+    int compute_attack(int power) const
+    {
+        return std::visit([power](const auto &weapon)
+        {
+            using T = std::decay_t<decltype(weapon)>;
+            if constexpr (std::is_same_v<T, std::monostate>)
+            {
+                return 0;
+            }
+            else
+            {
+                return weapon.compute_damage(power);
+            }
+        }, m_weapon);
+    }
+private:
+    WeaponVariant m_weapon;
+};
+
 void strategy_test()
 {
     Player player;
@@ -68,4 +139,64 @@ void strategy_test()
     player.set_weapon(ms);
     player.attack();
     player.set_weapon(ms);
-}
\ No newline at end of file
+}
+
+inline void strategy_variant_test()
+{
+    VariantPlayer player;
+    player.attack();
+    player.set_weapon(SwordStrategy{});
+    player.attack();
+    player.set_weapon(MagicStrategy{});
+    player.attack();
+    player.set_weapon(MagicStrategy{});
+}
+
+//基准：一批玩家交替持剑/持法杖，反复结算攻击
+inline void strategy_benchmark(std::size_t player_count = 1024, int rounds = 2000)
+{
+    using Clock = std::chrono::steady_clock;
+    auto sword = std::make_shared<SwordStrategy>();
+    auto magic = std::make_shared<MagicStrategy>();
+
+    std::vector<Player> players(player_count);
+    std::vector<VariantPlayer> variant_players(player_count);
+    for (std::size_t i = 0; i < player_count; ++i)
+    {
+        //按伪随机模式分配，避免分支预测器把两种武器完全猜中
+        const bool use_sword = ((i * 2654435761u) >> 7) & 1;
+        players[i].set_weapon(use_sword ? std::shared_ptr<IWeaponStrategy>(sword)
+                                        : std::shared_ptr<IWeaponStrategy>(magic));
+        variant_players[i].set_weapon(use_sword ? WeaponVariant(SwordStrategy{})
+                                                : WeaponVariant(MagicStrategy{}));
+    }
+
+    long long virtual_sum = 0;
+    auto t0 = Clock::now();
+    for (int r = 0; r < rounds; ++r)
+    {
+        for (std::size_t i = 0; i < player_count; ++i)
+        {
+            virtual_sum += players[i].compute_attack(static_cast<int>(i) + r);
+        }
+    }
+    auto t1 = Clock::now();
+
+    long long variant_sum = 0;
+    for (int r = 0; r < rounds; ++r)
+    {
+        for (std::size_t i = 0; i < player_count; ++i)
+        {
+            variant_sum += variant_players[i].compute_attack(static_cast<int>(i) + r);
+        }
+    }
+    auto t2 = Clock::now();
+
+    const double attacks = double(player_count) * rounds;
+    auto mps = [attacks](Clock::duration d)
+    { return attacks / std::chrono::duration<double>(d).count() / 1e6; };
+    printf("[Bench] %.0f attacks (checksum %s)\n", attacks,
+           virtual_sum == variant_sum ? "ok" : "MISMATCH");
+    printf("  virtual : %8.1f M attacks/s\n", mps(t1 - t0));
+    printf("  variant : %8.1f M attacks/s\n", mps(t2 - t1));
+}
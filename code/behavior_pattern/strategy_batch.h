@@ -0,0 +1,263 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "strategy.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define DP_BATCH_X86 1
+#include <immintrin.h>
+#else
+#define DP_BATCH_X86 0
+#endif
+
+// 批量伤害结算：一次处理大量攻击，按武器策略分组后用向量化内核计算
+// 公式与 SwordStrategy/MagicStrategy::compute_damage 保持一致：
+//   Sword: 50 + power      Magic: power * 2
+enum class WeaponId : std::uint8_t
+{
+    Sword,
+    Magic,
+    Count
+};
+
+// SoA 形式的一批攻击：结算只需要武器、攻击力和目标，攻击者已折算进 weapon
+struct AttackBatch
+{
+    std::vector<WeaponId> weapon;
+    std::vector<std::int32_t> power;
+    std::vector<std::uint32_t> target;
+
+    std::size_t size() const { return power.size(); }
+};
+
+namespace batch_kernel
+{
+// 内核对连续数组原地计算：输入 power，输出 damage
+using Kernel = void (*)(std::int32_t *values, std::size_t count);
+
+inline void sword_scalar(std::int32_t *values, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i) values[i] += 50;
+}
+
+inline void magic_scalar(std::int32_t *values, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i) values[i] *= 2;
+}
+
+#if DP_BATCH_X86
+__attribute__((target("sse2")))
+inline void sword_sse2(std::int32_t *values, std::size_t count)
+{
+    const __m128i bonus = _mm_set1_epi32(50);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(values + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(values + i), _mm_add_epi32(v, bonus));
+    }
+    sword_scalar(values + i, count - i);
+}
+
+__attribute__((target("sse2")))
+inline void magic_sse2(std::int32_t *values, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(values + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(values + i), _mm_slli_epi32(v, 1));
+    }
+    magic_scalar(values + i, count - i);
+}
+
+__attribute__((target("avx2")))
+inline void sword_avx2(std::int32_t *values, std::size_t count)
+{
+    const __m256i bonus = _mm256_set1_epi32(50);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(values + i), _mm256_add_epi32(v, bonus));
+    }
+    sword_scalar(values + i, count - i);
+}
+
+__attribute__((target("avx2")))
+inline void magic_avx2(std::int32_t *values, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(values + i), _mm256_slli_epi32(v, 1));
+    }
+    magic_scalar(values + i, count - i);
+}
+#endif
+
+struct KernelSet
+{
+    const char *name;
+    Kernel kernels[static_cast<std::size_t>(WeaponId::Count)];
+};
+
+inline const KernelSet &scalar_kernels()
+{
+    static const KernelSet set{"scalar", {&sword_scalar, &magic_scalar}};
+    return set;
+}
+
+// 运行期按 CPU 能力选择一次：AVX2 > SSE2 > 标量
+inline const KernelSet &best_kernels()
+{
+    static const KernelSet set = []
+    {
+#if DP_BATCH_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return KernelSet{"avx2", {&sword_avx2, &magic_avx2}};
+        }
+        if (__builtin_cpu_supports("sse2"))
+        {
+            return KernelSet{"sse2", {&sword_sse2, &magic_sse2}};
+        }
+#endif
+        return scalar_kernels();
+    }();
+    return set;
+}
+} // namespace batch_kernel
+
+// BatchCombat：复用分组/临时缓冲，反复结算时不再分配内存
+// resolve 对数据走三遍：计数排序（顺带收集攻击力）→ 每组一次内核 → 写回原顺序并扣血
+// 按武器分组是为了让每个内核都跑在连续数组上，代价是多出的分组和写回两遍
+class BatchCombat
+{
+public:
+    // 按值保存内核表（名字 + 几个函数指针），传入临时对象也安全
+    explicit BatchCombat(const batch_kernel::KernelSet &kernels = batch_kernel::best_kernels())
+    : m_kernels(kernels)
+    {}
+
+    const char *kernel_name() const { return m_kernels.name; }
+
+    // 结算整批攻击：damage[i] 为第 i 次攻击的伤害，同时从 target_health 扣血
+    void resolve(const AttackBatch &batch,
+                 std::vector<std::int32_t> &damage,
+                 std::vector<std::int32_t> &target_health)
+    {
+        const std::size_t n = batch.size();
+        damage.resize(n);
+
+        // 1. 计数排序：按武器把攻击下标分组
+        constexpr std::size_t kWeapons = static_cast<std::size_t>(WeaponId::Count);
+        std::size_t offsets[kWeapons + 1] = {};
+        for (WeaponId w : batch.weapon)
+        {
+            ++offsets[static_cast<std::size_t>(w) + 1];
+        }
+        for (std::size_t w = 0; w < kWeapons; ++w)
+        {
+            offsets[w + 1] += offsets[w];
+        }
+        m_order.resize(n);
+        m_values.resize(n);
+        std::size_t cursor[kWeapons];
+        for (std::size_t w = 0; w < kWeapons; ++w) cursor[w] = offsets[w];
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const std::size_t slot = cursor[static_cast<std::size_t>(batch.weapon[i])]++;
+            m_order[slot] = static_cast<std::uint32_t>(i);
+            m_values[slot] = batch.power[i]; // 顺带收集成连续数组
+        }
+
+        // 2. 每组跑一次向量化内核
+        for (std::size_t w = 0; w < kWeapons; ++w)
+        {
+            m_kernels.kernels[w](m_values.data() + offsets[w], offsets[w + 1] - offsets[w]);
+        }
+
+        // 3. 写回原顺序，并结算到目标
+        for (std::size_t slot = 0; slot < n; ++slot)
+        {
+            const std::uint32_t i = m_order[slot];
+            damage[i] = m_values[slot];
+            target_health[batch.target[i]] -= m_values[slot];
+        }
+    }
+
+private:
+    batch_kernel::KernelSet m_kernels;
+    std::vector<std::uint32_t> m_order;
+    std::vector<std::int32_t> m_values;
+};
+
+// 测试 + 基准：与逐次调用 Player::compute_attack 的结果逐项比对，再比较吞吐
+inline void strategy_batch_test(std::size_t attack_count = 1000000,
+                                std::size_t player_count = 4096)
+{
+    using Clock = std::chrono::steady_clock;
+    std::mt19937 rng(42);
+
+    auto sword = std::make_shared<SwordStrategy>();
+    auto magic = std::make_shared<MagicStrategy>();
+    std::vector<WeaponId> weapon_of(player_count);
+    std::vector<Player> players(player_count);
+    for (std::size_t p = 0; p < player_count; ++p)
+    {
+        weapon_of[p] = (rng() & 1) ? WeaponId::Sword : WeaponId::Magic;
+        if (weapon_of[p] == WeaponId::Sword) players[p].set_weapon(sword);
+        else players[p].set_weapon(magic);
+    }
+
+    AttackBatch batch;
+    std::vector<std::uint32_t> attacker; // 只给逐次调用的参考版本用
+    for (std::size_t i = 0; i < attack_count; ++i)
+    {
+        const auto p = static_cast<std::uint32_t>(rng() % player_count);
+        attacker.push_back(p);
+        batch.weapon.push_back(weapon_of[p]);
+        batch.power.push_back(static_cast<std::int32_t>(rng() % 1000));
+        batch.target.push_back(static_cast<std::uint32_t>(rng() % player_count));
+    }
+
+    // 逐次调用的参考结果
+    std::vector<std::int32_t> expected(attack_count);
+    std::vector<std::int32_t> expected_health(player_count, 1 << 30);
+    auto t0 = Clock::now();
+    for (std::size_t i = 0; i < attack_count; ++i)
+    {
+        expected[i] = players[attacker[i]].compute_attack(batch.power[i]);
+        expected_health[batch.target[i]] -= expected[i];
+    }
+    auto t1 = Clock::now();
+
+    auto run = [&](const batch_kernel::KernelSet &kernels)
+    {
+        BatchCombat combat(kernels);
+        std::vector<std::int32_t> damage;
+        std::vector<std::int32_t> health(player_count, 1 << 30);
+        combat.resolve(batch, damage, health); // 预热，分配缓冲
+        health.assign(player_count, 1 << 30);
+        auto start = Clock::now();
+        combat.resolve(batch, damage, health);
+        auto stop = Clock::now();
+        const bool ok = damage == expected && health == expected_health;
+        const double secs = std::chrono::duration<double>(stop - start).count();
+        std::printf("  batch %-6s: %8.1f M attacks/s  %s\n", kernels.name,
+                    attack_count / secs / 1e6, ok ? "match" : "MISMATCH");
+    };
+
+    std::printf("[Batch] %zu attacks\n", attack_count);
+    std::printf("  per-call    : %8.1f M attacks/s\n",
+                attack_count / std::chrono::duration<double>(t1 - t0).count() / 1e6);
+    run(batch_kernel::scalar_kernels());
+    run(batch_kernel::best_kernels());
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "strategy.h"
+#include "../utility/epoch_reclaim.h"
+
+// 并发版玩家：工作线程不断 attack()，其他线程随时 set_weapon()
+// Player::set_weapon 直接给 shared_ptr 赋值，与读者并发时是数据竞争；
+// 这里用 RcuSlot 保存策略：读者一次 acquire 读取、无引用计数，写者原子发布，
+// 旧策略由 EpochDomain 在没有读者时回收
+class ConcurrentPlayer
+{
+public:
+    void set_weapon(std::unique_ptr<IWeaponStrategy> weapon)
+    {
+        m_weapon.publish(weapon.release());
+    }
+
+    void attack() const
+    {
+        EpochDomain::Guard guard;
+        const IWeaponStrategy *weapon = m_weapon.load();
+        if (weapon == nullptr)
+        {
+            printf("where's your weapon?\n");
+            return;
+        }
+        weapon->damage();
+    }
+
+    int compute_attack(int power) const
+    {
+        EpochDomain::Guard guard;
+        const IWeaponStrategy *weapon = m_weapon.load();
+        return weapon ? weapon->compute_damage(power) : 0;
+    }
+
+private:
+    RcuSlot<IWeaponStrategy> m_weapon;
+};
+
+// 演示：读者线程各自结算固定次数，主线程在此期间反复换武器
+inline void strategy_rcu_test(int reader_count = 4, int attacks_per_reader = 200000)
+{
+    ConcurrentPlayer player;
+    player.attack();
+    player.set_weapon(std::make_unique<SwordStrategy>());
+    player.attack();
+
+    std::atomic<int> finished{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < reader_count; ++r)
+    {
+        readers.emplace_back([&]
+        {
+            for (int i = 0; i < attacks_per_reader; ++i)
+            {
+                const int dmg = player.compute_attack(10);
+                if (dmg != 60 && dmg != 20) // Sword: 50+10, Magic: 10*2
+                {
+                    printf("[Rcu] unexpected damage %d\n", dmg);
+                }
+            }
+            finished.fetch_add(1);
+        });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    long long swaps = 0;
+    while (finished.load() < reader_count)
+    {
+        if (swaps++ & 1) player.set_weapon(std::make_unique<SwordStrategy>());
+        else player.set_weapon(std::make_unique<MagicStrategy>());
+        std::this_thread::yield();
+    }
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+    auto secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    EpochDomain::instance().reclaim();
+    printf("[Rcu] %d readers x %d attacks, %lld swaps in %.3fs, pending reclaim %zu\n",
+           reader_count, attacks_per_reader, swaps, secs,
+           EpochDomain::instance().pending());
+    player.set_weapon(std::make_unique<MagicStrategy>());
+    player.attack();
+}
@@ -1,24 +1,76 @@
 #pragma once
 #include<iostream>
+#include<string>
+#include<string_view>
+
+#include "../utility/mapped_file.h"
 
 //模板方法
 class DataLoader
 {
 public:
-    void load() 
+    explicit DataLoader(std::string path = {}) : m_path(std::move(path)) {}
+
+    //返回 false 表示文件打不开，此时跳过解析与创建，已有对象保持不变
+    bool load() 
     {
-        read_file();
-        parse_data();
-        create_obj();
+        const bool opened = read_file();
+        if (opened && !restore_cached()) //钩子：命中预编译缓存时跳过解析与创建
+        {
+            parse_data();
+            create_obj();
+        }
         clean_up();
+        return opened;
     }
-    void read_file()
-    {printf("load_file\n");}
+    //固定步骤：只读映射文件，子类在 parse_data 里通过 data() 原地解析，不拷贝
+    //映射失败返回 false
+    bool read_file()
+    {
+        if (m_path.empty())
+        {
+            printf("load_file\n"); //未指定文件：保持演示用的桩行为
+            return true;
+        }
+        if (!m_file.open(m_path))
+        {
+            printf("[DataLoader] open failed: %s\n", m_path.c_str());
+            return false;
+        }
+        m_data = std::string_view(m_file.data(), m_file.size());
+        return true;
+    }
+    //钩子方法：默认不使用缓存；子类可在此校验并恢复预编译结果，返回 true 表示已完成加载
+    virtual bool restore_cached() { return false; }
     virtual void parse_data() = 0;
     virtual void create_obj() = 0;
+    //固定步骤：解除映射，data() 中的视图从此失效
     void clean_up()
-    {printf("clean_up\n");}
+    {
+        if (m_path.empty())
+        {
+            printf("clean_up\n");
+            return;
+        }
+        m_data = {};
+        m_file.close();
+    }
     virtual ~DataLoader() = default;
+
+    const std::string &path() const { return m_path; }
+    void set_path(std::string path) { m_path = std::move(path); }
+
+    //可选：在 read_file 之后把文件页提前读入内存（并行流水线的 I/O 阶段调用）
+    void prefetch() const { m_file.prefault(); }
+
+protected:
+    //只在 parse_data/create_obj 期间有效的只读视图
+    std::string_view data() const { return m_data; }
+
+private:
+    std::string m_path;
+    MappedFile m_file;
+    std::string_view m_data;
 };
 
 class CharacterLoader : public DataLoader
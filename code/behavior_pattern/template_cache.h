@@ -0,0 +1,324 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "template_table.h"
+#include "../utility/content_hash.h"
+#include "../utility/mapped_file.h"
+
+// 预编译缓存：第一次解析成功后，把结果写成紧凑的二进制镜像；之后启动时
+// 只要源文件内容哈希一致，就直接映射镜像，跳过 parse_data/create_obj
+//
+// 镜像布局（全部用偏移而不是指针，映射到任意地址都可直接使用；按本机字节序存放）
+//   CacheHeader
+//   CacheRecord[count]               定长记录，名字以 (偏移, 长度) 引用
+//   names                            所有名字首尾相接
+struct CacheHeader
+{
+    char magic[4];               // "DLCI"
+    std::uint32_t version;       // 格式或解析规则变化时递增，旧缓存自动作废
+    std::uint64_t source_hash;   // 源文件内容哈希
+    std::uint64_t source_size;
+    std::uint64_t count;
+    std::uint64_t names_offset;
+    std::uint64_t names_size;
+    std::uint64_t bad_rows;      // 解析时跳过的坏行数，热启动时原样报告
+};
+
+// 偏移和长度都用 64 位：名字区超过 4 GiB 时也不会回绕
+struct CacheRecord
+{
+    std::uint64_t name_offset; // 相对 names 区
+    std::uint64_t name_length;
+    std::int32_t attack;
+    std::int32_t health;
+};
+
+static_assert(sizeof(CacheRecord) == 24, "cache record layout is part of the file format");
+
+// 缓存与内存两种来源共用的只读视图
+struct CharacterView
+{
+    std::string_view name;
+    int attack;
+    int health;
+};
+
+class CompiledCharacterLoader : public DataLoader
+{
+public:
+    static constexpr std::uint32_t kVersion = 3;
+
+    CompiledCharacterLoader(std::string path, std::string cache_path)
+        : DataLoader(std::move(path)), m_cache_path(std::move(cache_path))
+    {
+    }
+
+    // 校验缓存：魔数、版本、源文件哈希与大小、各区边界、每条记录的名字范围，任一不符都回到解析
+    // 逐条检查记录之后，at() 就不必再做边界判断，损坏或截断的缓存也不会让它读出映射区
+    bool restore_cached() override
+    {
+        const std::string_view source = data();
+        if (source.empty())
+        {
+            return false;
+        }
+        MappedFile cache;
+        if (!cache.open(m_cache_path) || cache.size() < sizeof(CacheHeader))
+        {
+            return false;
+        }
+        CacheHeader header;
+        std::memcpy(&header, cache.data(), sizeof(header));
+        const std::uint64_t records_end = sizeof(CacheHeader) + header.count * sizeof(CacheRecord);
+        if (std::memcmp(header.magic, "DLCI", 4) != 0
+            || header.version != kVersion
+            || header.source_size != source.size()
+            || header.count > cache.size() / sizeof(CacheRecord)
+            || header.names_offset < records_end
+            || header.names_offset > cache.size()
+            || header.names_size > cache.size() - header.names_offset
+            || header.source_hash != content_hash(source))
+        {
+            return false;
+        }
+        const char *records = cache.data() + sizeof(CacheHeader);
+        for (std::uint64_t i = 0; i < header.count; ++i)
+        {
+            CacheRecord record;
+            std::memcpy(&record, records + i * sizeof(CacheRecord), sizeof(record));
+            if (record.name_offset > header.names_size
+                || record.name_length > header.names_size - record.name_offset)
+            {
+                return false;
+            }
+        }
+
+        m_cache = std::move(cache);
+        m_owned.clear();
+        m_from_cache = true;
+        m_bad_rows = static_cast<std::size_t>(header.bad_rows);
+        attach(m_cache.data(), m_cache.size());
+        return true;
+    }
+
+    // 直接把行解析成镜像格式：内存中的结果与写盘的内容完全一致
+    void parse_data() override
+    {
+        std::vector<CacheRecord> records;
+        std::string names;
+        m_bad_rows = for_each_table_row(data(), [&](std::string_view name, int attack, int health)
+        {
+            records.push_back({names.size(), name.size(), attack, health});
+            names.append(name.data(), name.size());
+        });
+
+        CacheHeader header{};
+        std::memcpy(header.magic, "DLCI", 4);
+        header.version = kVersion;
+        header.source_hash = content_hash(data());
+        header.source_size = data().size();
+        header.count = records.size();
+        header.names_offset = sizeof(CacheHeader) + records.size() * sizeof(CacheRecord);
+        header.names_size = names.size();
+        header.bad_rows = m_bad_rows;
+
+        m_owned.resize(header.names_offset + names.size());
+        std::memcpy(&m_owned[0], &header, sizeof(header));
+        if (!records.empty())
+        {
+            std::memcpy(&m_owned[sizeof(CacheHeader)], records.data(), records.size() * sizeof(CacheRecord));
+        }
+        if (!names.empty())
+        {
+            std::memcpy(&m_owned[header.names_offset], names.data(), names.size());
+        }
+    }
+
+    // 写出缓存（临时文件 + 改名，中途失败不会留下半个镜像），内存中保留同一份镜像
+    void create_obj() override
+    {
+        m_cache.close();
+        m_from_cache = false;
+        attach(m_owned.data(), m_owned.size());
+
+        const std::string temp = m_cache_path + ".tmp";
+        std::FILE *fp = std::fopen(temp.c_str(), "wb");
+        if (!fp)
+        {
+            return;
+        }
+        const bool ok = std::fwrite(m_owned.data(), 1, m_owned.size(), fp) == m_owned.size();
+        if (std::fclose(fp) != 0 || !ok || std::rename(temp.c_str(), m_cache_path.c_str()) != 0)
+        {
+            std::remove(temp.c_str());
+            printf("[DataLoader] cache write failed: %s\n", m_cache_path.c_str());
+        }
+    }
+
+    std::size_t size() const { return m_count; }
+
+    CharacterView at(std::size_t i) const
+    {
+        CacheRecord record;
+        std::memcpy(&record, m_records + i * sizeof(CacheRecord), sizeof(record));
+        return {std::string_view(m_names + static_cast<std::size_t>(record.name_offset),
+                                 static_cast<std::size_t>(record.name_length)),
+                record.attack, record.health};
+    }
+
+    bool from_cache() const { return m_from_cache; }
+    std::size_t bad_rows() const { return m_bad_rows; }
+
+private:
+    void attach(const char *image, std::size_t size)
+    {
+        if (size < sizeof(CacheHeader))
+        {
+            m_count = 0;
+            return;
+        }
+        CacheHeader header;
+        std::memcpy(&header, image, sizeof(header));
+        m_count = static_cast<std::size_t>(header.count);
+        m_records = image + sizeof(CacheHeader);
+        m_names = image + header.names_offset;
+    }
+
+    std::string m_cache_path;
+    MappedFile m_cache;   // 命中缓存：映射的镜像
+    std::string m_owned;  // 刚解析：内存中的镜像
+    bool m_from_cache{false};
+    std::size_t m_bad_rows{0};
+
+    std::size_t m_count{0};
+    const char *m_records{nullptr};
+    const char *m_names{nullptr};
+};
+
+inline void template_cache_test()
+{
+    const std::string path = "characters_cache_demo.csv";
+    const std::string cache_path = path + ".bin";
+    auto write_source = [&path](const char *text)
+    {
+        std::FILE *fp = std::fopen(path.c_str(), "wb");
+        std::fputs(text, fp);
+        std::fclose(fp);
+    };
+    auto show = [](const char *tag, const CompiledCharacterLoader &loader)
+    {
+        printf("[%s] from_cache=%d bad_rows=%zu\n", tag, loader.from_cache(), loader.bad_rows());
+        for (std::size_t i = 0; i < loader.size(); ++i)
+        {
+            const CharacterView c = loader.at(i);
+            printf("  %.*s atk=%d hp=%d\n", static_cast<int>(c.name.size()), c.name.data(), c.attack, c.health);
+        }
+    };
+
+    std::remove(cache_path.c_str());
+    write_source("Knight,50,300\nMage,80,150\nBroken\n");
+    {
+        CompiledCharacterLoader cold(path, cache_path);
+        cold.load();
+        show("cold", cold);
+    }
+    {
+        CompiledCharacterLoader warm(path, cache_path);
+        warm.load();
+        show("warm", warm);
+    }
+    {
+        // 破坏第一条记录的名字长度：校验不通过，回到解析
+        std::FILE *fp = std::fopen(cache_path.c_str(), "r+b");
+        const std::uint64_t huge = 0x7fffffff;
+        std::fseek(fp, static_cast<long>(sizeof(CacheHeader) + offsetof(CacheRecord, name_length)), SEEK_SET);
+        std::fwrite(&huge, sizeof(huge), 1, fp);
+        std::fclose(fp);
+        CompiledCharacterLoader corrupted(path, cache_path);
+        corrupted.load();
+        show("corrupted", corrupted);
+    }
+    write_source("Knight,55,300\nMage,80,150\nArcher,65,200\n"); // 内容变化，缓存作废
+    {
+        CompiledCharacterLoader changed(path, cache_path);
+        changed.load();
+        show("changed", changed);
+    }
+    std::remove(path.c_str());
+    std::remove(cache_path.c_str());
+}
+
+// 基准：同一份角色表，冷启动（解析 + 写缓存）与热启动（哈希校验 + 映射镜像）对比
+// 另附原来的 CharacterTableLoader（解析 + 逐个建 std::string）作参照；文件处于页缓存中
+inline void template_cache_benchmark(std::size_t size_mb = 256)
+{
+    using Clock = std::chrono::steady_clock;
+    const std::string path = "characters_cache_bench.csv";
+    const std::string cache_path = path + ".bin";
+    write_character_table(path, size_mb);
+    std::remove(cache_path.c_str());
+
+    auto secs = [](Clock::duration d) { return std::chrono::duration<double>(d).count(); };
+    struct Tally
+    {
+        std::size_t rows{0};
+        long long attack{0};
+        long long health{0};
+        std::size_t name_bytes{0};
+    };
+    auto tally_of = [](const CompiledCharacterLoader &loader)
+    {
+        Tally tally;
+        for (std::size_t i = 0; i < loader.size(); ++i)
+        {
+            const CharacterView c = loader.at(i);
+            ++tally.rows;
+            tally.attack += c.attack;
+            tally.health += c.health;
+            tally.name_bytes += c.name.size();
+        }
+        return tally;
+    };
+
+    auto t0 = Clock::now();
+    Tally plain;
+    {
+        CharacterTableLoader loader(path);
+        loader.load();
+        for (const auto &c : loader.characters())
+        {
+            ++plain.rows;
+            plain.attack += c.attack;
+            plain.health += c.health;
+            plain.name_bytes += c.name.size();
+        }
+    }
+    auto t1 = Clock::now();
+    CompiledCharacterLoader cold(path, cache_path);
+    cold.load();
+    auto t2 = Clock::now();
+    CompiledCharacterLoader warm(path, cache_path);
+    warm.load();
+    auto t3 = Clock::now();
+
+    const Tally a = tally_of(cold);
+    const Tally b = tally_of(warm);
+    const bool same = !cold.from_cache() && warm.from_cache()
+                      && a.rows == b.rows && a.attack == b.attack && a.health == b.health
+                      && a.name_bytes == b.name_bytes && a.rows == plain.rows
+                      && a.attack == plain.attack && a.name_bytes == plain.name_bytes;
+    printf("[Bench] %zu MB, %zu rows (%s)\n", size_mb, a.rows, same ? "match" : "MISMATCH");
+    printf("  table loader (parse + strings): %7.3f s\n", secs(t1 - t0));
+    printf("  cold (parse + write cache)    : %7.3f s\n", secs(t2 - t1));
+    printf("  warm (hash + map cache)       : %7.3f s (%.1fx vs cold)\n",
+           secs(t3 - t2), secs(t2 - t1) / secs(t3 - t2));
+    std::remove(path.c_str());
+    std::remove(cache_path.c_str());
+}
@@ -0,0 +1,211 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "template_table.h"
+#include "../utility/bounded_queue.h"
+
+// 多文件并行加载：仍然调用模板方法的四个步骤，但让它们在不同线程上重叠执行
+//   I/O 线程：read_file() + prefetch()     —— 第 N+1 个文件的读盘与第 N 个的解析重叠
+//   解析线程池：restore_cached() / parse_data() —— 多个文件同时解析
+//   创建线程：create_obj() + clean_up()     —— 按提交顺序执行（ordered_create）
+// 阶段之间用有界队列连接；另有一个窗口限制在途文件数：第 i 个文件要等
+// “已放行的文件数 + queue_capacity > i” 才开始读盘，所以即使保序时第 0 个文件解析很慢，
+// 后面堆在重排缓冲里的文件也不超过 queue_capacity 个，内存中同时存在的映射文件数量有上限
+struct LoadPipelineOptions
+{
+    std::size_t parse_threads{std::max(1u, std::thread::hardware_concurrency())};
+    std::size_t queue_capacity{8}; // 同时也是在途文件数的上限
+    bool ordered_create{true}; // create_obj 是否必须按提交顺序执行
+};
+
+// 返回打不开的文件数；这些文件跳过解析与创建，只做 clean_up
+inline std::size_t load_all(const std::vector<DataLoader *> &loaders,
+                            const LoadPipelineOptions &options = {})
+{
+    struct Job
+    {
+        std::size_t index;
+        DataLoader *loader;
+        bool opened{true};
+        bool restored{false}; // 命中缓存：跳过 create_obj
+    };
+
+    const std::size_t window = std::max<std::size_t>(1, options.queue_capacity);
+    BoundedQueue<Job> read_done(window);
+    BoundedQueue<Job> parse_done(window);
+
+    // 已放行（create_obj + clean_up 完成）的文件数；I/O 线程据此限制在途文件数
+    std::size_t released = 0;
+    std::mutex window_mutex;
+    std::condition_variable window_cv;
+
+    std::thread io_thread([&]
+    {
+        for (std::size_t i = 0; i < loaders.size(); ++i)
+        {
+            {
+                std::unique_lock<std::mutex> lock(window_mutex);
+                window_cv.wait(lock, [&] { return i < released + window; });
+            }
+            const bool opened = loaders[i]->read_file();
+            if (opened)
+            {
+                loaders[i]->prefetch();
+            }
+            read_done.push({i, loaders[i], opened});
+        }
+        read_done.close();
+    });
+
+    std::vector<std::thread> parsers;
+    const std::size_t parse_threads = std::max<std::size_t>(1, options.parse_threads);
+    std::size_t parsers_left = parse_threads;
+    std::mutex parsers_mutex;
+    for (std::size_t t = 0; t < parse_threads; ++t)
+    {
+        parsers.emplace_back([&]
+        {
+            while (auto job = read_done.pop())
+            {
+                if (!job->opened)
+                {
+                    // 打不开：原样交给下游，只做 clean_up
+                }
+                else if (!job->loader->restore_cached())
+                {
+                    job->loader->parse_data();
+                }
+                else
+                {
+                    job->restored = true;
+                }
+                parse_done.push(*job);
+            }
+            std::lock_guard<std::mutex> lock(parsers_mutex);
+            if (--parsers_left == 0)
+            {
+                parse_done.close(); // 最后一个解析线程退出时关闭下游
+            }
+        });
+    }
+
+    // 创建阶段在调用线程执行；需要保序时用重排缓冲按下标依次放行
+    std::map<std::size_t, Job> reorder; // 最多 window 个
+    std::size_t next = 0;
+    std::size_t failed = 0;
+    auto finish = [&](const Job &job)
+    {
+        if (!job.opened)
+        {
+            ++failed;
+        }
+        else if (!job.restored)
+        {
+            job.loader->create_obj();
+        }
+        job.loader->clean_up();
+        {
+            std::lock_guard<std::mutex> lock(window_mutex);
+            ++released;
+        }
+        window_cv.notify_one();
+    };
+    while (auto job = parse_done.pop())
+    {
+        if (!options.ordered_create)
+        {
+            finish(*job);
+            continue;
+        }
+        reorder.emplace(job->index, *job);
+        for (auto it = reorder.find(next); it != reorder.end(); it = reorder.find(next))
+        {
+            finish(it->second);
+            reorder.erase(it);
+            ++next;
+        }
+    }
+
+    io_thread.join();
+    for (auto &parser : parsers)
+    {
+        parser.join();
+    }
+    return failed;
+}
+
+// 基准：file_count 个小表，顺序 load() 与 1~16 线程流水线对比
+inline void template_pipeline_benchmark(std::size_t file_count = 2000,
+                                        std::size_t rows_per_file = 4000)
+{
+    using Clock = std::chrono::steady_clock;
+    namespace fs = std::filesystem;
+    const fs::path dir = "pipeline_bench_data";
+    fs::create_directories(dir);
+
+    std::vector<std::string> paths;
+    for (std::size_t f = 0; f < file_count; ++f)
+    {
+        const std::string path = (dir / ("characters_" + std::to_string(f) + ".csv")).string();
+        std::FILE *fp = std::fopen(path.c_str(), "wb");
+        if (!fp)
+        {
+            continue;
+        }
+        for (std::size_t r = 0; r < rows_per_file; ++r)
+        {
+            std::fprintf(fp, "hero%zu_%zu,%zu,%zu\n", f, r, 10 + r % 990, 100 + (r * 7) % 9900);
+        }
+        std::fclose(fp);
+        paths.push_back(path);
+    }
+
+    auto make_loaders = [&paths]
+    {
+        std::vector<std::unique_ptr<CharacterTableLoader>> owned;
+        for (const auto &path : paths)
+        {
+            owned.push_back(std::make_unique<CharacterTableLoader>(path));
+        }
+        return owned;
+    };
+    auto secs = [](Clock::duration d) { return std::chrono::duration<double>(d).count(); };
+
+    {
+        auto owned = make_loaders();
+        auto t0 = Clock::now();
+        for (auto &loader : owned)
+        {
+            loader->load();
+        }
+        printf("[Bench] %zu files x %zu rows\n", paths.size(), rows_per_file);
+        printf("  sequential load() : %7.3f s\n", secs(Clock::now() - t0));
+    }
+
+    for (std::size_t threads : {1, 2, 4, 8, 16})
+    {
+        auto owned = make_loaders();
+        std::vector<DataLoader *> loaders;
+        for (auto &loader : owned)
+        {
+            loaders.push_back(loader.get());
+        }
+        LoadPipelineOptions options;
+        options.parse_threads = threads;
+        auto t0 = Clock::now();
+        load_all(loaders, options);
+        printf("  pipeline %2zu thread: %7.3f s\n", threads, secs(Clock::now() - t0));
+    }
+
+    fs::remove_all(dir);
+}
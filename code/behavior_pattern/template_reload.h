@@ -0,0 +1,406 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "template_table.h"
+#include "../utility/content_hash.h"
+
+// 增量热重载：只重新解析内容真正变化的文件，只修补受影响的对象
+// - 第一层：mtime + 大小不变的文件直接跳过，不打开
+// - 第二层：mtime 变了就映射文件算内容哈希；哈希不变（只是被 touch）则通过 restore_cached 钩子跳过解析
+// - 第三层：内容变了才 parse_data/create_obj，再逐个对象比较哈希，只增删改有差异的对象
+
+// 记录上次内容哈希的角色表加载器：哈希未变时由钩子直接结束本次加载
+class TrackedCharacterLoader : public CharacterTableLoader
+{
+public:
+    using CharacterTableLoader::CharacterTableLoader;
+
+    bool restore_cached() override
+    {
+        const std::uint64_t hash = content_hash(data());
+        m_unchanged = m_hashed && hash == m_hash;
+        m_hash = hash;
+        m_hashed = true;
+        return m_unchanged;
+    }
+
+    bool unchanged() const { return m_unchanged; }
+
+private:
+    std::uint64_t m_hash{0};
+    bool m_hashed{false};
+    bool m_unchanged{false};
+};
+
+struct ReloadStats
+{
+    std::size_t files_checked{0};
+    std::size_t files_touched{0};  // mtime 变了但内容相同
+    std::size_t files_reparsed{0};
+    std::size_t files_failed{0};   // stat 到了但打不开（如正被替换），下次 reload 重试
+    std::size_t objects_added{0};
+    std::size_t objects_updated{0};
+    std::size_t objects_removed{0};
+};
+
+class CharacterCatalog
+{
+public:
+    void add_source(std::string path)
+    {
+        m_sources.push_back({std::make_unique<TrackedCharacterLoader>(std::move(path)), {}, 0, false, {}});
+    }
+
+    // 首次调用即全量加载；之后只处理变化的文件
+    ReloadStats reload()
+    {
+        namespace fs = std::filesystem;
+        ReloadStats stats;
+        for (std::size_t index = 0; index < m_sources.size(); ++index)
+        {
+            Source &source = m_sources[index];
+            ++stats.files_checked;
+
+            std::error_code ec;
+            const fs::directory_entry entry(source.loader->path(), ec); // 一次 stat，同时拿到 mtime 与大小
+            const bool exists = !ec && entry.is_regular_file(ec);
+            if (!exists)
+            {
+                if (source.seen)
+                {
+                    patch(index, {}, stats); // 文件被删：移除它产出的对象
+                    source = {std::make_unique<TrackedCharacterLoader>(source.loader->path()), {}, 0, false, {}};
+                }
+                continue;
+            }
+            const auto mtime = entry.last_write_time(ec);
+            const auto size = entry.file_size(ec);
+            if (source.seen && mtime == source.mtime && size == source.size)
+            {
+                continue;
+            }
+            if (!source.loader->load())
+            {
+                ++stats.files_failed; // 不记录 mtime，下次 reload 重试；已有对象保持不变
+                continue;
+            }
+            source.mtime = mtime;
+            source.size = size;
+            source.seen = true;
+
+            if (source.loader->unchanged())
+            {
+                ++stats.files_touched;
+                continue;
+            }
+            ++stats.files_reparsed;
+            patch(index, source.loader->characters(), stats);
+        }
+        return stats;
+    }
+
+    const CharacterData *find(std::string_view name) const
+    {
+        auto it = m_objects.find(std::string(name));
+        return it == m_objects.end() ? nullptr : &it->second.data;
+    }
+
+    std::size_t size() const { return m_objects.size(); }
+
+private:
+    struct Source
+    {
+        std::unique_ptr<TrackedCharacterLoader> loader;
+        std::filesystem::file_time_type mtime;
+        std::uintmax_t size;
+        bool seen;
+        std::vector<std::string> keys; // 该文件产出的对象
+    };
+
+    // 提供某个对象的一行：文件下标 + 该文件 characters() 中的行号
+    // 行号只在该文件重新解析时变化，而那时 patch 会刷新它名下的全部对象
+    struct Provider
+    {
+        std::size_t source;
+        std::size_t row;
+    };
+
+    struct Entry
+    {
+        CharacterData data;
+        std::uint64_t hash;  // 对象内容哈希，用来判断是否需要修补
+        Provider active;     // 当前生效的提供者；同名对象以下标最大的文件为准，与全量加载一致
+    };
+
+    static std::uint64_t object_hash(const CharacterData &c)
+    {
+        const std::uint64_t fields = static_cast<std::uint64_t>(static_cast<std::uint32_t>(c.attack)) << 32
+                                     | static_cast<std::uint32_t>(c.health);
+        return content_hash(c.name, fields);
+    }
+
+    void patch(std::size_t index, const std::vector<CharacterData> &rows, ReloadStats &stats)
+    {
+        Source &source = m_sources[index];
+        std::unordered_map<std::string_view, std::size_t> incoming; // 名字 -> 行号，同名取最后一行
+        incoming.reserve(rows.size());
+        for (std::size_t row = 0; row < rows.size(); ++row)
+        {
+            incoming[rows[row].name] = row;
+        }
+
+        // 旧对象中不再出现的：撤下本文件这个提供者，还有别的文件提供时退回到它
+        for (const auto &key : source.keys)
+        {
+            if (!incoming.count(key))
+            {
+                drop_provider(key, index, stats);
+            }
+        }
+
+        // 新增或内容变化的：写入；本文件已生效且内容未变的保持原对象不动
+        // 优先级固定为文件下标（后登记的覆盖先登记的），与编辑顺序无关，增量结果总与全量加载一致
+        source.keys.clear();
+        source.keys.reserve(incoming.size());
+        for (const auto &item : incoming)
+        {
+            const CharacterData &row = rows[item.second];
+            const Provider provider{index, item.second};
+            const std::uint64_t hash = object_hash(row);
+            auto result = m_objects.try_emplace(row.name, Entry{row, hash, provider});
+            Entry &entry = result.first->second;
+            if (result.second)
+            {
+                ++stats.objects_added;
+            }
+            else if (entry.active.source == index)
+            {
+                entry.active.row = item.second;
+                if (entry.hash != hash)
+                {
+                    entry.data = row;
+                    entry.hash = hash;
+                    ++stats.objects_updated;
+                }
+            }
+            else if (index > entry.active.source)
+            {
+                // 本文件优先级更高：接管；原提供者转为候补
+                std::vector<Provider> &standby = m_standby[row.name];
+                remove_standby(standby, index);
+                insert_standby(standby, entry.active);
+                entry = Entry{row, hash, provider};
+                ++stats.objects_updated;
+            }
+            else
+            {
+                // 优先级更低：只记为候补（或刷新行号），生效对象不变
+                std::vector<Provider> &standby = m_standby[row.name];
+                remove_standby(standby, index);
+                insert_standby(standby, provider);
+            }
+            source.keys.push_back(row.name);
+        }
+    }
+
+    void drop_provider(const std::string &key, std::size_t index, ReloadStats &stats)
+    {
+        auto it = m_objects.find(key);
+        if (it == m_objects.end())
+        {
+            return;
+        }
+        auto standby = m_standby.find(key);
+        if (it->second.active.source != index)
+        {
+            if (standby != m_standby.end())
+            {
+                remove_standby(standby->second, index);
+                if (standby->second.empty())
+                {
+                    m_standby.erase(standby);
+                }
+            }
+            return;
+        }
+        if (standby == m_standby.end())
+        {
+            m_objects.erase(it);
+            ++stats.objects_removed;
+            return;
+        }
+        // 退回到优先级最高的候补
+        const Provider fallback = standby->second.back();
+        standby->second.pop_back();
+        if (standby->second.empty())
+        {
+            m_standby.erase(standby);
+        }
+        const CharacterData &row = m_sources[fallback.source].loader->characters()[fallback.row];
+        it->second = Entry{row, object_hash(row), fallback};
+        ++stats.objects_updated;
+    }
+
+    // 候补按文件下标升序排列，back() 优先级最高
+    static void insert_standby(std::vector<Provider> &standby, const Provider &provider)
+    {
+        auto pos = std::lower_bound(standby.begin(), standby.end(), provider,
+                                    [](const Provider &a, const Provider &b) { return a.source < b.source; });
+        standby.insert(pos, provider);
+    }
+
+    static void remove_standby(std::vector<Provider> &standby, std::size_t index)
+    {
+        standby.erase(std::remove_if(standby.begin(), standby.end(),
+                                     [index](const Provider &p) { return p.source == index; }),
+                      standby.end());
+    }
+
+    std::vector<Source> m_sources;
+    std::unordered_map<std::string, Entry> m_objects;
+    // 同名对象的其他提供者（按文件下标升序）；只有多个文件提供同一名字时才有条目
+    std::unordered_map<std::string, std::vector<Provider>> m_standby;
+};
+
+inline void template_reload_test()
+{
+    namespace fs = std::filesystem;
+    const fs::path dir = "reload_demo_data";
+    fs::create_directories(dir);
+    auto write = [&dir](const char *name, const char *text)
+    {
+        std::FILE *fp = std::fopen((dir / name).string().c_str(), "wb");
+        std::fputs(text, fp);
+        std::fclose(fp);
+    };
+    auto print = [](const char *tag, const ReloadStats &s)
+    {
+        printf("[%s] checked=%zu touched=%zu reparsed=%zu +%zu ~%zu -%zu\n", tag, s.files_checked,
+               s.files_touched, s.files_reparsed, s.objects_added, s.objects_updated, s.objects_removed);
+    };
+
+    write("heroes.csv", "Knight,50,300\nMage,80,150\n");
+    write("monsters.csv", "Slime,5,30\nDragon,300,5000\n");
+    write("bosses.csv", "Dragon,999,9999\n"); // 与 monsters.csv 同名，后登记的文件生效
+    CharacterCatalog catalog;
+    catalog.add_source((dir / "heroes.csv").string());
+    catalog.add_source((dir / "monsters.csv").string());
+    catalog.add_source((dir / "bosses.csv").string());
+    print("initial", catalog.reload());
+    print("no change", catalog.reload());
+
+    const auto later = fs::last_write_time(dir / "monsters.csv") + std::chrono::seconds(1);
+    fs::last_write_time(dir / "monsters.csv", later); // 只 touch，不改内容
+    print("touch", catalog.reload());
+
+    write("heroes.csv", "Knight,55,300\nArcher,65,200\n");
+    fs::last_write_time(dir / "heroes.csv", later + std::chrono::seconds(1));
+    print("edit", catalog.reload());
+    const CharacterData *knight = catalog.find("Knight");
+    printf("Knight atk=%d, Mage %s, Archer %s, total %zu\n", knight ? knight->attack : -1,
+           catalog.find("Mage") ? "present" : "removed", catalog.find("Archer") ? "present" : "missing",
+           catalog.size());
+
+    auto dragon_attack = [&catalog]
+    {
+        const CharacterData *dragon = catalog.find("Dragon");
+        return dragon ? dragon->attack : -1;
+    };
+    printf("Dragon atk=%d (from bosses.csv)\n", dragon_attack());
+
+    // 只改 monsters.csv 里的 Slime：重新解析低优先级文件不能抢走 Dragon，结果要和全量加载一致
+    write("monsters.csv", "Slime,6,30\nDragon,300,5000\n");
+    fs::last_write_time(dir / "monsters.csv", later + std::chrono::seconds(2));
+    print("edit shadowed", catalog.reload());
+    CharacterCatalog rebuilt;
+    for (const char *name : {"heroes.csv", "monsters.csv", "bosses.csv"})
+    {
+        rebuilt.add_source((dir / name).string());
+    }
+    rebuilt.reload();
+    const CharacterData *full_dragon = rebuilt.find("Dragon");
+    printf("Dragon atk=%d, full load atk=%d (%s)\n", dragon_attack(), full_dragon ? full_dragon->attack : -1,
+           full_dragon && dragon_attack() == full_dragon->attack ? "consistent" : "MISMATCH");
+
+    fs::remove(dir / "bosses.csv");
+    print("delete override", catalog.reload());
+    printf("Dragon atk=%d (falls back to monsters.csv)\n", dragon_attack());
+
+    fs::remove(dir / "monsters.csv");
+    print("delete", catalog.reload());
+    printf("Dragon atk=%d (no provider left)\n", dragon_attack());
+    fs::remove_all(dir);
+}
+
+// 基准：file_count 个文件，改动其中一个后增量 reload，与全量重建对比
+inline void template_reload_benchmark(std::size_t file_count = 10000, std::size_t rows_per_file = 100)
+{
+    using Clock = std::chrono::steady_clock;
+    namespace fs = std::filesystem;
+    const fs::path dir = "reload_bench_data";
+    fs::create_directories(dir);
+
+    auto write_file = [&](std::size_t f, int bump)
+    {
+        const std::string path = (dir / ("characters_" + std::to_string(f) + ".csv")).string();
+        std::FILE *fp = std::fopen(path.c_str(), "wb");
+        for (std::size_t r = 0; r < rows_per_file; ++r)
+        {
+            std::fprintf(fp, "hero%zu_%zu,%zu,%zu\n", f, r, 10 + r % 990 + (r == 0 ? bump : 0),
+                         100 + (r * 7) % 9900);
+        }
+        std::fclose(fp);
+        return path;
+    };
+
+    CharacterCatalog catalog;
+    std::vector<std::string> paths;
+    for (std::size_t f = 0; f < file_count; ++f)
+    {
+        paths.push_back(write_file(f, 0));
+        catalog.add_source(paths.back());
+    }
+    auto ms = [](Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); };
+
+    auto t0 = Clock::now();
+    catalog.reload();
+    auto t1 = Clock::now();
+    catalog.reload();
+    auto t2 = Clock::now();
+
+    const std::size_t changed = file_count / 2;
+    write_file(changed, 1);
+    fs::last_write_time(paths[changed], fs::last_write_time(paths[changed]) + std::chrono::seconds(1));
+    auto t3 = Clock::now();
+    const ReloadStats stats = catalog.reload();
+    auto t4 = Clock::now();
+
+    // 对照：今天的做法，任何改动都重建全部数据
+    auto t5 = Clock::now();
+    {
+        CharacterCatalog full;
+        for (const auto &path : paths)
+        {
+            full.add_source(path);
+        }
+        full.reload();
+    }
+    auto t6 = Clock::now();
+
+    printf("[Bench] %zu files x %zu rows, %zu objects\n", file_count, rows_per_file, catalog.size());
+    printf("  initial load            : %8.2f ms\n", ms(t1 - t0));
+    printf("  reload, nothing changed : %8.2f ms\n", ms(t2 - t1));
+    printf("  reload, one file edited : %8.2f ms (reparsed %zu, updated %zu objects)\n",
+           ms(t4 - t3), stats.files_reparsed, stats.objects_updated);
+    printf("  full rebuild            : %8.2f ms\n", ms(t6 - t5));
+    fs::remove_all(dir);
+}
@@ -0,0 +1,558 @@
+#pragma once
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "template_table.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define DP_SCAN_X86 1
+#include <immintrin.h>
+#else
+#define DP_SCAN_X86 0
+#endif
+
+// 解析工具：供 DataLoader 子类在 parse_data() 里使用
+// - 分隔符扫描：每次处理 64 字节，得到“分隔符或换行”的位掩码，再逐位取出位置
+// - 数字转换：整数/浮点数的快速路径，遇到少见格式时回退到 std::from_chars，结果与其一致
+namespace scan
+{
+// 内核：返回 p[0..64) 中等于 delim 或 '\n' 的字节位掩码（第 i 位对应 p[i]）
+using Kernel = std::uint64_t (*)(const char *p, char delim);
+
+// 标量回退：一次比较 8 个字节（SWAR），再把每字节的命中位收拢成 8 位
+inline std::uint64_t zero_byte_bits(std::uint64_t x)
+{
+    const std::uint64_t low7 = 0x7f7f7f7f7f7f7f7full;
+    return ~(((x & low7) + low7) | x | low7); // 每个为 0 的字节置其最高位，无误报
+}
+
+inline std::uint64_t mask_scalar(const char *p, char delim)
+{
+    const std::uint64_t ones = 0x0101010101010101ull;
+    const std::uint64_t d = ones * static_cast<unsigned char>(delim);
+    const std::uint64_t nl = ones * static_cast<unsigned char>('\n');
+    std::uint64_t mask = 0;
+    for (int i = 0; i < 8; ++i)
+    {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        std::uint64_t bits = 0;
+        for (int j = 0; j < 8; ++j)
+        {
+            bits |= static_cast<std::uint64_t>(p[i * 8 + j] == delim || p[i * 8 + j] == '\n') << j;
+        }
+#else
+        std::uint64_t word;
+        std::memcpy(&word, p + i * 8, 8);
+        const std::uint64_t hit = zero_byte_bits(word ^ d) | zero_byte_bits(word ^ nl);
+        const std::uint64_t bits = ((hit >> 7) * 0x0102040810204080ull) >> 56;
+#endif
+        mask |= bits << (i * 8);
+    }
+    return mask;
+}
+
+#if DP_SCAN_X86
+__attribute__((target("sse2")))
+inline std::uint64_t mask_sse2(const char *p, char delim)
+{
+    const __m128i d = _mm_set1_epi8(delim);
+    const __m128i nl = _mm_set1_epi8('\n');
+    std::uint64_t mask = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i * 16));
+        const __m128i hit = _mm_or_si128(_mm_cmpeq_epi8(v, d), _mm_cmpeq_epi8(v, nl));
+        mask |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(hit))) << (i * 16);
+    }
+    return mask;
+}
+
+__attribute__((target("avx2")))
+inline std::uint64_t mask_avx2(const char *p, char delim)
+{
+    const __m256i d = _mm256_set1_epi8(delim);
+    const __m256i nl = _mm256_set1_epi8('\n');
+    const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + 32));
+    const __m256i hit_lo = _mm256_or_si256(_mm256_cmpeq_epi8(lo, d), _mm256_cmpeq_epi8(lo, nl));
+    const __m256i hit_hi = _mm256_or_si256(_mm256_cmpeq_epi8(hi, d), _mm256_cmpeq_epi8(hi, nl));
+    const auto m_lo = static_cast<std::uint32_t>(_mm256_movemask_epi8(hit_lo));
+    const auto m_hi = static_cast<std::uint32_t>(_mm256_movemask_epi8(hit_hi));
+    return static_cast<std::uint64_t>(m_hi) << 32 | m_lo;
+}
+#endif
+
+struct KernelInfo
+{
+    const char *name;
+    Kernel kernel;
+};
+
+inline const KernelInfo &scalar_kernel()
+{
+    static const KernelInfo info{"scalar", &mask_scalar};
+    return info;
+}
+
+// 运行期按 CPU 能力选择一次：AVX2 > SSE2 > 标量
+inline const KernelInfo &best_kernel()
+{
+    static const KernelInfo info = []
+    {
+#if DP_SCAN_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return KernelInfo{"avx2", &mask_avx2};
+        }
+        if (__builtin_cpu_supports("sse2"))
+        {
+            return KernelInfo{"sse2", &mask_sse2};
+        }
+#endif
+        return scalar_kernel();
+    }();
+    return info;
+}
+
+inline int lowest_bit(std::uint64_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(mask);
+#else
+    int i = 0;
+    while (!(mask & 1)) { mask >>= 1; ++i; }
+    return i;
+#endif
+}
+
+// 依次给出 text 中每个分隔符/换行的位置；末尾不足 64 字节的块先拷进补零缓冲
+class DelimiterScanner
+{
+public:
+    explicit DelimiterScanner(std::string_view text, char delim = ',',
+                              const KernelInfo &kernel = best_kernel())
+    : m_text(text), m_delim(delim), m_kernel(kernel.kernel)
+    {
+        load_block();
+    }
+
+    // 下一个分隔符或换行的位置；扫描完毕返回 text.size()
+    std::size_t next()
+    {
+        while (m_mask == 0)
+        {
+            m_base += 64;
+            if (m_base >= m_text.size())
+            {
+                m_base = m_text.size();
+                return m_text.size();
+            }
+            load_block();
+        }
+        const std::size_t pos = m_base + static_cast<std::size_t>(lowest_bit(m_mask));
+        m_mask &= m_mask - 1;
+        return pos;
+    }
+
+private:
+    void load_block()
+    {
+        const std::size_t left = m_text.size() - m_base;
+        if (left >= 64)
+        {
+            m_mask = m_kernel(m_text.data() + m_base, m_delim);
+            return;
+        }
+        char tail[64] = {};
+        std::memcpy(tail, m_text.data() + m_base, left);
+        m_mask = left == 0 ? 0 : m_kernel(tail, m_delim) & (~0ull >> (64 - left));
+    }
+
+    std::string_view m_text;
+    char m_delim;
+    Kernel m_kernel;
+    std::size_t m_base{0};
+    std::uint64_t m_mask{0};
+};
+
+// 按行切分字段：fn(const std::string_view *fields, std::size_t count)
+// 行尾 '\r' 去掉，空行跳过；超过 MaxFields 的字段并入不再切分（被忽略）
+template <std::size_t MaxFields = 16, typename Fn>
+void for_each_row(std::string_view text, Fn &&fn, char delim = ',',
+                  const KernelInfo &kernel = best_kernel())
+{
+    DelimiterScanner scanner(text, delim, kernel);
+    std::string_view fields[MaxFields];
+    std::size_t count = 0;
+    std::size_t field_start = 0;
+    const char *base = text.data();
+    for (;;)
+    {
+        const std::size_t pos = scanner.next();
+        const bool line_end = pos == text.size() || base[pos] == '\n';
+        if (count < MaxFields)
+        {
+            fields[count++] = std::string_view(base + field_start, pos - field_start);
+        }
+        field_start = pos + 1;
+        if (!line_end)
+        {
+            continue;
+        }
+        std::string_view &last = fields[count - 1];
+        if (!last.empty() && last.back() == '\r')
+        {
+            last.remove_suffix(1);
+        }
+        if (count > 1 || !fields[0].empty())
+        {
+            fn(static_cast<const std::string_view *>(fields), count);
+        }
+        count = 0;
+        if (pos >= text.size() || pos + 1 == text.size())
+        {
+            return;
+        }
+    }
+}
+
+// 整数：可选 '-'，必须整段都是数字（"12abc" 失败，与 for_each_table_row 的要求一致），溢出失败
+// 常见的短数字走手写循环，十位以上交给 std::from_chars
+inline bool parse_int(std::string_view s, int &out)
+{
+    const char *p = s.data();
+    const char *end = p + s.size();
+    const bool negative = p != end && *p == '-';
+    p += negative;
+    const char *digits = p;
+    std::uint64_t value = 0;
+    while (p != end && static_cast<unsigned>(*p - '0') < 10 && p - digits < 10)
+    {
+        value = value * 10 + static_cast<unsigned>(*p - '0');
+        ++p;
+    }
+    if (p == digits)
+    {
+        return false;
+    }
+    if (p != end && static_cast<unsigned>(*p - '0') < 10)
+    {
+        // 十位以上（含前导零）交给标准库
+        const auto result = std::from_chars(s.data(), end, out);
+        return result.ec == std::errc() && result.ptr == end;
+    }
+    if (p != end)
+    {
+        return false; // 数字后面还有别的字符
+    }
+    const std::uint64_t limit = negative ? 2147483648ull : 2147483647ull;
+    if (value > limit)
+    {
+        return false;
+    }
+    out = negative ? static_cast<int>(-static_cast<std::int64_t>(value)) : static_cast<int>(value);
+    return true;
+}
+
+// 浮点数：尾数不超过 2^53 且十进制指数在 ±22 以内时，一次乘/除即为正确舍入的结果
+// （Clinger 快速路径）；其余情况回退 std::from_chars，结果与其逐位一致
+inline bool parse_double(std::string_view s, double &out)
+{
+    static constexpr double kPow10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    auto fallback = [&] { return std::from_chars(s.data(), s.data() + s.size(), out).ec == std::errc(); };
+
+    const char *p = s.data();
+    const char *end = p + s.size();
+    const bool negative = p != end && *p == '-';
+    p += negative;
+
+    std::uint64_t mantissa = 0;
+    int digit_count = 0;
+    int exponent = 0;
+    while (p != end && static_cast<unsigned>(*p - '0') < 10)
+    {
+        mantissa = mantissa * 10 + static_cast<unsigned>(*p++ - '0');
+        ++digit_count;
+    }
+    if (p != end && *p == '.')
+    {
+        ++p;
+        while (p != end && static_cast<unsigned>(*p - '0') < 10)
+        {
+            mantissa = mantissa * 10 + static_cast<unsigned>(*p++ - '0');
+            ++digit_count;
+            --exponent;
+        }
+    }
+    if (digit_count == 0 || digit_count > 19)
+    {
+        return fallback(); // inf/nan/".e"/超长尾数等
+    }
+    if (p != end && (*p == 'e' || *p == 'E'))
+    {
+        const char *q = p + 1;
+        const bool exp_negative = q != end && *q == '-';
+        q += (q != end && (*q == '-' || *q == '+'));
+        int exp_value = 0;
+        const char *exp_digits = q;
+        while (q != end && static_cast<unsigned>(*q - '0') < 10 && q - exp_digits < 4)
+        {
+            exp_value = exp_value * 10 + (*q++ - '0');
+        }
+        if (q == exp_digits)
+        {
+            // 只有 'e' 没有指数数字：与 from_chars 相同，把 'e' 之前当作完整数字
+        }
+        else if (q != end && static_cast<unsigned>(*q - '0') < 10)
+        {
+            return fallback();
+        }
+        else
+        {
+            exponent += exp_negative ? -exp_value : exp_value;
+        }
+    }
+    if (mantissa > (1ull << 53) || exponent < -22 || exponent > 22)
+    {
+        return fallback();
+    }
+    double value = static_cast<double>(mantissa);
+    value = exponent < 0 ? value / kPow10[-exponent] : value * kPow10[exponent];
+    out = negative ? -value : value;
+    return true;
+}
+
+// 与 for_each_table_row 语义相同的 "name,a,b" 行解析，换用向量化扫描和快速整数转换
+// 按逗号位置直接推进，不经过 for_each_row 的字段数组；出现第三个逗号（多余字段）算坏行
+template <typename Fn>
+std::size_t scan_table_rows(std::string_view text, Fn &&fn,
+                            const KernelInfo &kernel = best_kernel())
+{
+    DelimiterScanner scanner(text, ',', kernel);
+    const char *base = text.data();
+    const std::size_t n = text.size();
+    std::size_t bad_rows = 0;
+    std::size_t start = 0;
+    while (start < n)
+    {
+        const std::size_t c1 = scanner.next();
+        if (c1 == n || base[c1] == '\n')
+        {
+            std::size_t len = c1 - start;
+            if (len > 0 && base[c1 - 1] == '\r')
+            {
+                --len;
+            }
+            bad_rows += len > 0; // 空行跳过，否则缺字段
+            start = c1 + 1;
+            continue;
+        }
+        const std::size_t c2 = scanner.next();
+        if (c2 == n || base[c2] == '\n')
+        {
+            ++bad_rows;
+            start = c2 + 1;
+            continue;
+        }
+        std::size_t end = scanner.next();
+        if (end != n && base[end] != '\n')
+        {
+            ++bad_rows; // 多余字段：跳过本行剩余部分
+            do
+            {
+                end = scanner.next();
+            } while (end != n && base[end] != '\n');
+            start = end + 1;
+            continue;
+        }
+        std::size_t b_end = end;
+        if (b_end > c2 + 1 && base[b_end - 1] == '\r')
+        {
+            --b_end;
+        }
+        int a = 0;
+        int b = 0;
+        if (parse_int(std::string_view(base + c1 + 1, c2 - c1 - 1), a)
+            && parse_int(std::string_view(base + c2 + 1, b_end - c2 - 1), b))
+        {
+            fn(std::string_view(base + start, c1 - start), a, b);
+        }
+        else
+        {
+            ++bad_rows;
+        }
+        start = end + 1;
+    }
+    return bad_rows;
+}
+} // namespace scan
+
+inline void template_scan_test()
+{
+    const std::string_view text = "Knight,50,300\r\nMage,-80,150\n\nbroken line\nArcher,65,200,extra\n"
+                                  "Rogue,12abc,90\nBig,99999999999,1\nCleric,30,120";
+    auto print = [](std::string_view name, int a, int b)
+    {
+        printf("  %.*s %d %d\n", static_cast<int>(name.size()), name.data(), a, b);
+    };
+    printf("[Scan] for_each_table_row\n");
+    const std::size_t table_bad = for_each_table_row(text, print);
+    printf("  bad rows: %zu\n", table_bad);
+    printf("[Scan] scan::scan_table_rows (%s)\n", scan::best_kernel().name);
+    const std::size_t scan_bad = scan::scan_table_rows(text, print);
+    printf("  bad rows: %zu (%s)\n", scan_bad, scan_bad == table_bad ? "match" : "MISMATCH");
+
+    for (const char *s : {"3.25", "-0.5", "1e10", "2.5E-3", "12345678901234567890", "1e400", "inf", "7e", "abc"})
+    {
+        double fast = 0;
+        double ref = 0;
+        const bool ok_fast = scan::parse_double(s, fast);
+        const bool ok_ref = std::from_chars(s, s + std::strlen(s), ref).ec == std::errc();
+        printf("  parse_double(%s) = %g %s\n", s, fast,
+               ok_fast == ok_ref && (!ok_fast || fast == ref) ? "match" : "MISMATCH");
+    }
+}
+
+// 基准：size_mb 大小的角色表（页缓存中的 std::string），吞吐按输入字节计算
+inline void template_scan_benchmark(std::size_t size_mb = 256)
+{
+    using Clock = std::chrono::steady_clock;
+    const std::string path = "characters_scan_bench.csv";
+    write_character_table(path, size_mb);
+    std::string text;
+    {
+        MappedFile file(path);
+        text.assign(file.data(), file.size());
+    }
+    std::remove(path.c_str());
+
+    const double gb = static_cast<double>(text.size()) / 1e9;
+    auto gbps = [gb](Clock::duration d) { return gb / std::chrono::duration<double>(d).count(); };
+
+    // 1. 只找分隔符
+    printf("[Bench] %zu MB table\n", size_mb);
+    for (const scan::KernelInfo *kernel : {&scan::scalar_kernel(), &scan::best_kernel()})
+    {
+        auto t0 = Clock::now();
+        scan::DelimiterScanner scanner(text, ',', *kernel);
+        std::size_t hits = 0;
+        while (scanner.next() < text.size())
+        {
+            ++hits;
+        }
+        printf("  delimiter scan %-6s  : %6.2f GB/s (%zu hits)\n", kernel->name, gbps(Clock::now() - t0), hits);
+    }
+
+    // 2. 整行解析：原 for_each_table_row 与 scan_table_rows
+    struct Tally
+    {
+        std::size_t rows{0};
+        long long attack{0};
+        long long health{0};
+        std::size_t name_bytes{0};
+    };
+    auto tally_into = [](Tally &tally)
+    {
+        return [&tally](std::string_view name, int a, int b)
+        {
+            ++tally.rows;
+            tally.attack += a;
+            tally.health += b;
+            tally.name_bytes += name.size();
+        };
+    };
+    Tally reference;
+    auto t0 = Clock::now();
+    for_each_table_row(text, tally_into(reference));
+    printf("  for_each_table_row      : %6.2f GB/s\n", gbps(Clock::now() - t0));
+    for (const scan::KernelInfo *kernel : {&scan::scalar_kernel(), &scan::best_kernel()})
+    {
+        Tally tally;
+        t0 = Clock::now();
+        scan::scan_table_rows(text, tally_into(tally), *kernel);
+        const bool same = tally.rows == reference.rows && tally.attack == reference.attack
+                          && tally.health == reference.health && tally.name_bytes == reference.name_bytes;
+        printf("  scan_table_rows %-6s : %6.2f GB/s %s\n", kernel->name, gbps(Clock::now() - t0),
+               same ? "match" : "MISMATCH");
+    }
+
+    // 3. 数字转换：同一批整数/小数文本，from_chars 与快速路径
+    std::vector<std::string_view> ints;
+    scan::for_each_row<3>(text, [&ints](const std::string_view *fields, std::size_t count)
+    {
+        for (std::size_t i = 1; i < count; ++i) ints.push_back(fields[i]);
+    });
+    std::size_t int_bytes = 0;
+    for (auto s : ints) int_bytes += s.size();
+
+    std::string float_text;
+    std::vector<std::string_view> floats;
+    {
+        std::vector<std::size_t> offsets;
+        char buf[32];
+        for (std::size_t i = 0; i < ints.size() / 2; ++i)
+        {
+            const int len = std::snprintf(buf, sizeof(buf), "%.3f", (i * 7919 % 1000003) / 64.0);
+            offsets.push_back(float_text.size());
+            float_text.append(buf, static_cast<std::size_t>(len));
+        }
+        offsets.push_back(float_text.size());
+        for (std::size_t i = 0; i + 1 < offsets.size(); ++i)
+        {
+            floats.emplace_back(float_text.data() + offsets[i], offsets[i + 1] - offsets[i]);
+        }
+    }
+
+    auto bench_numbers = [&](const char *label, const std::vector<std::string_view> &items,
+                             std::size_t bytes, auto &&convert)
+    {
+        double sum = 0;
+        auto start = Clock::now();
+        for (auto s : items) sum += convert(s);
+        const double secs = std::chrono::duration<double>(Clock::now() - start).count();
+        printf("  %-24s: %6.2f GB/s %7.1f M/s (sum %.6g)\n", label, bytes / 1e9 / secs,
+               items.size() / secs / 1e6, sum);
+    };
+    bench_numbers("int from_chars", ints, int_bytes, [](std::string_view s)
+    {
+        int v = 0;
+        std::from_chars(s.data(), s.data() + s.size(), v);
+        return static_cast<double>(v);
+    });
+    bench_numbers("int scan::parse_int", ints, int_bytes, [](std::string_view s)
+    {
+        int v = 0;
+        scan::parse_int(s, v);
+        return static_cast<double>(v);
+    });
+    bench_numbers("double strtod", floats, float_text.size(), [](std::string_view s)
+    {
+        char buf[32];
+        std::memcpy(buf, s.data(), s.size());
+        buf[s.size()] = '\0';
+        return std::strtod(buf, nullptr);
+    });
+    bench_numbers("double from_chars", floats, float_text.size(), [](std::string_view s)
+    {
+        double v = 0;
+        std::from_chars(s.data(), s.data() + s.size(), v);
+        return v;
+    });
+    bench_numbers("double scan::parse_double", floats, float_text.size(), [](std::string_view s)
+    {
+        double v = 0;
+        scan::parse_double(s, v);
+        return v;
+    });
+}
@@ -0,0 +1,253 @@
+#pragma once
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "template.h"
+
+// 表格数据：每行 "name,a,b\n"，两个整数字段的含义由具体加载器决定
+// 解析直接在只读视图上切分，name 以 string_view 形式交给回调，不做拷贝
+// 两个整数字段必须完整解析（"12abc" 这类带尾巴的也算坏行），返回格式错误而被跳过的行数
+template <typename Fn>
+std::size_t for_each_table_row(std::string_view text, Fn &&fn)
+{
+    std::size_t bad_rows = 0;
+    std::size_t pos = 0;
+    while (pos < text.size())
+    {
+        std::size_t end = text.find('\n', pos);
+        if (end == std::string_view::npos)
+        {
+            end = text.size();
+        }
+        std::string_view line = text.substr(pos, end - pos);
+        pos = end + 1;
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.remove_suffix(1);
+        }
+        if (line.empty())
+        {
+            continue;
+        }
+
+        const std::size_t c1 = line.find(',');
+        const std::size_t c2 = c1 == std::string_view::npos ? c1 : line.find(',', c1 + 1);
+        if (c2 == std::string_view::npos)
+        {
+            ++bad_rows;
+            continue;
+        }
+        int a = 0;
+        int b = 0;
+        const char *first = line.data();
+        const auto ra = std::from_chars(first + c1 + 1, first + c2, a);
+        const auto rb = std::from_chars(first + c2 + 1, first + line.size(), b);
+        if (ra.ec != std::errc() || ra.ptr != first + c2
+            || rb.ec != std::errc() || rb.ptr != first + line.size())
+        {
+            ++bad_rows;
+            continue;
+        }
+        fn(line.substr(0, c1), a, b);
+    }
+    return bad_rows;
+}
+
+struct CharacterData
+{
+    std::string name;
+    int attack;
+    int health;
+};
+
+struct ItemData
+{
+    std::string name;
+    int attribute;
+    int price;
+};
+
+// 表格加载器的公共部分：parse_data 在视图上切出行，create_obj 再逐行拷贝成 Data
+// Data 须能以 {name, a, b} 聚合初始化，两个整数字段的含义由 Data 的成员顺序决定
+template <typename Data>
+class TableLoader : public DataLoader
+{
+public:
+    using DataLoader::DataLoader;
+
+    void parse_data() override
+    {
+        m_rows.clear();
+        m_bad_rows = for_each_table_row(data(), [this](std::string_view name, int a, int b)
+        {
+            m_rows.push_back({name, a, b});
+        });
+    }
+
+    void create_obj() override
+    {
+        m_objects.clear();
+        m_objects.reserve(m_rows.size());
+        for (const auto &row : m_rows)
+        {
+            m_objects.push_back(Data{std::string(row.name), row.a, row.b});
+        }
+        m_rows.clear(); // 视图在 clean_up 后失效，不保留
+    }
+
+    std::size_t bad_rows() const { return m_bad_rows; }
+
+protected:
+    const std::vector<Data> &objects() const { return m_objects; }
+
+private:
+    struct Row
+    {
+        std::string_view name;
+        int a;
+        int b;
+    };
+
+    std::vector<Row> m_rows;
+    std::vector<Data> m_objects;
+    std::size_t m_bad_rows{0};
+};
+
+// 角色表："name,attack,health"
+class CharacterTableLoader : public TableLoader<CharacterData>
+{
+public:
+    using TableLoader::TableLoader;
+
+    const std::vector<CharacterData> &characters() const { return objects(); }
+};
+
+// 物品表："name,attribute,price"
+class ItemTableLoader : public TableLoader<ItemData>
+{
+public:
+    using TableLoader::TableLoader;
+
+    const std::vector<ItemData> &items() const { return objects(); }
+};
+
+// 生成 size_mb 大小的角色表（基准与演示用）
+inline void write_character_table(const std::string &path, std::size_t size_mb)
+{
+    std::FILE *fp = std::fopen(path.c_str(), "wb");
+    if (!fp)
+    {
+        return;
+    }
+    const std::size_t target = size_mb * 1024 * 1024;
+    std::string chunk;
+    std::size_t written = 0;
+    unsigned id = 0;
+    char line[64];
+    while (written < target)
+    {
+        chunk.clear();
+        while (chunk.size() < (1 << 20))
+        {
+            const int len = std::snprintf(line, sizeof(line), "hero%u,%u,%u\n",
+                                          id, 10 + id % 990, 100 + (id * 7) % 9900);
+            chunk.append(line, static_cast<std::size_t>(len));
+            ++id;
+        }
+        std::fwrite(chunk.data(), 1, chunk.size(), fp);
+        written += chunk.size();
+    }
+    std::fclose(fp);
+}
+
+inline void template_table_test()
+{
+    const std::string path = "characters_demo.csv";
+    {
+        std::ofstream out(path);
+        out << "Knight,50,300\nMage,80,150\nbroken line\nRogue,12abc,90\nArcher,65,200\n";
+    }
+    CharacterTableLoader loader(path);
+    if (!loader.load())
+    {
+        printf("load failed: %s\n", path.c_str());
+    }
+    for (const auto &c : loader.characters())
+    {
+        printf("create->%s atk=%d hp=%d\n", c.name.c_str(), c.attack, c.health);
+    }
+    printf("bad rows: %zu\n", loader.bad_rows());
+    std::remove(path.c_str());
+
+    CharacterTableLoader missing("no_such_table.csv");
+    printf("missing file -> load() %s\n", missing.load() ? "ok" : "failed");
+}
+
+// 基准：同一份数据，ifstream 读入 std::string 后解析 vs 内存映射原地解析
+// 两种方式都只做统计（不建对象），只比较“读入 + 切分”的开销；文件处于页缓存中
+inline void template_mmap_benchmark(std::size_t size_mb = 1024)
+{
+    using Clock = std::chrono::steady_clock;
+    const std::string path = "characters_bench.csv";
+    write_character_table(path, size_mb);
+
+    struct Tally
+    {
+        std::size_t rows{0};
+        long long attack{0};
+        long long health{0};
+    };
+    auto tally_rows = [](std::string_view text, Tally &tally)
+    {
+        for_each_table_row(text, [&tally](std::string_view, int attack, int health)
+        {
+            ++tally.rows;
+            tally.attack += attack;
+            tally.health += health;
+        });
+    };
+
+    // ifstream + string
+    Tally by_stream;
+    auto t0 = Clock::now();
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::string content;
+        in.seekg(0, std::ios::end);
+        content.resize(static_cast<std::size_t>(in.tellg()));
+        in.seekg(0, std::ios::beg);
+        in.read(&content[0], static_cast<std::streamsize>(content.size()));
+        tally_rows(content, by_stream);
+    }
+    auto t1 = Clock::now();
+
+    // 内存映射 + 模板方法
+    class StatsLoader : public DataLoader
+    {
+    public:
+        using DataLoader::DataLoader;
+        Tally tally;
+        void (*tally_fn)(std::string_view, Tally &){nullptr};
+        void parse_data() override { tally_fn(data(), tally); }
+        void create_obj() override {}
+    };
+    StatsLoader loader(path);
+    loader.tally_fn = tally_rows;
+    auto t2 = Clock::now();
+    loader.load();
+    auto t3 = Clock::now();
+
+    auto secs = [](Clock::duration d) { return std::chrono::duration<double>(d).count(); };
+    const bool same = by_stream.rows == loader.tally.rows
+                      && by_stream.attack == loader.tally.attack
+                      && by_stream.health == loader.tally.health;
+    printf("[Bench] %zu MB, %zu rows (%s)\n", size_mb, by_stream.rows, same ? "match" : "MISMATCH");
+    printf("  ifstream+string: %7.3f s\n", secs(t1 - t0));
+    printf("  mmap in place  : %7.3f s\n", secs(t3 - t2));
+    std::remove(path.c_str());
+}
@@ -1,7 +1,11 @@
 #pragma once
+#include <chrono>
+#include <cstdio>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <utility>
+#include <variant>
 #include <vector>
 
 class PassiveSkill;
@@ -48,23 +52,46 @@ public:
     void accept(ISkillVisitor &visitor) override { visitor.visit(*this); }
 };
 
-class RenderVisitor : public ISkillVisitor
+// 某一类技能的一段列数据（SoA）：名字与数值分开存放，批量访问只读 data
+template <typename Skill>
+struct SkillColumn
+{
+    const std::string *names;
+    const int *data;
+    std::size_t size;
+};
+
+// 列中单个元素的只读视图：直接引用列里的名字和数值，不构造节点、不拷贝字符串
+template <typename Skill>
+struct SkillView
+{
+    const std::string &name;
+    const int &data;
+};
+
+class RenderVisitor final : public ISkillVisitor
 {
 public:
-    void visit(PassiveSkill &skill) override
+    void visit(PassiveSkill &skill) override { print_passive(skill.name(), skill.data()); }
+    void visit(ActiveSkill &skill) override { print_active(skill.name(), skill.data()); }
+
+    // 列存储（SkillPartitions）的逐元素路径
+    void visit(SkillView<PassiveSkill> skill) { print_passive(skill.name, skill.data); }
+    void visit(SkillView<ActiveSkill> skill) { print_active(skill.name, skill.data); }
+
+private:
+    static void print_passive(const std::string &name, int data)
     {
-        std::cout << "[Passive] " << skill.name()
-                  << " + " << skill.data() << " bonus\n";
+        std::cout << "[Passive] " << name << " + " << data << " bonus\n";
     }
 
-    void visit(ActiveSkill &skill) override
+    static void print_active(const std::string &name, int data)
     {
-        std::cout << "[Active] " << skill.name()
-                  << " cooldown " << skill.data() << "s\n";
+        std::cout << "[Active] " << name << " cooldown " << data << "s\n";
     }
 };
 
-class StatsVisitor : public ISkillVisitor
+class StatsVisitor final : public ISkillVisitor
 {
 public:
     void visit(PassiveSkill &skill) override
@@ -78,6 +105,44 @@ public:
         ++m_active_count;
     }
 
+    // 批量路径：只扫一段连续的 int；8 路独立累加，-O2 下也能被编译器向量化
+    void visit_all(SkillColumn<PassiveSkill> column)
+    {
+        int lanes[8] = {};
+        std::size_t i = 0;
+        for (; i + 8 <= column.size; i += 8)
+        {
+            for (int k = 0; k < 8; ++k)
+            {
+                lanes[k] += column.data[i + k];
+            }
+        }
+        int total = 0;
+        for (; i < column.size; ++i)
+        {
+            total += column.data[i];
+        }
+        for (int lane : lanes)
+        {
+            total += lane;
+        }
+        m_total_bonus += total;
+        m_passive_count += static_cast<int>(column.size);
+    }
+
+    void visit_all(SkillColumn<ActiveSkill> column)
+    {
+        m_active_count += static_cast<int>(column.size);
+    }
+
+    // 并行遍历时合并另一个分段的结果
+    void merge(const StatsVisitor &other)
+    {
+        m_passive_count += other.m_passive_count;
+        m_active_count += other.m_active_count;
+        m_total_bonus += other.m_total_bonus;
+    }
+
     void print_result() const
     {
         std::cout << "[Stats] passive=" << m_passive_count
@@ -85,12 +150,54 @@ public:
                   << ", total bonus=" << m_total_bonus << "\n";
     }
 
+    int passive_count() const { return m_passive_count; }
+    int active_count() const { return m_active_count; }
+    int total_bonus() const { return m_total_bonus; }
+
 private:
     int m_passive_count{0};
     int m_active_count{0};
     int m_total_bonus{0};
 };
 
+// 值语义的技能容器：节点按值连续存放在 std::variant 里，不再逐个堆分配
+// accept 用 std::visit 取得具体类型，再调用访问者对应的 visit 重载：
+// 现有 RenderVisitor/StatsVisitor 无需修改，任何提供两个 visit 重载的类型都能用；
+// 访问者类型标了 final 时，编译器可以把 visit 调用去虚化并内联
+using SkillValue = std::variant<PassiveSkill, ActiveSkill>;
+
+class SkillArray
+{
+public:
+    template <typename Skill, typename... Args>
+    Skill &add(Args &&...args)
+    {
+        return std::get<Skill>(m_skills.emplace_back(std::in_place_type<Skill>, std::forward<Args>(args)...));
+    }
+
+    void reserve(std::size_t count) { m_skills.reserve(count); }
+    std::size_t size() const { return m_skills.size(); }
+
+    template <typename Visitor>
+    void accept(Visitor &visitor)
+    {
+        accept(visitor, 0, m_skills.size());
+    }
+
+    // 只访问 [first, last) 区间，供并行遍历按段切分
+    template <typename Visitor>
+    void accept(Visitor &visitor, std::size_t first, std::size_t last)
+    {
+        for (std::size_t i = first; i < last; ++i)
+        {
+            std::visit([&visitor](auto &node) { visitor.visit(node); }, m_skills[i]);
+        }
+    }
+
+private:
+    std::vector<SkillValue> m_skills;
+};
+
 inline void visitor_test()
 {
     std::vector<std::shared_ptr<SkillNode>> skills{
@@ -114,3 +221,77 @@ inline void visitor_test()
     stats.print_result();
 }
 
+
+inline void visitor_variant_test()
+{
+    SkillArray skills;
+    skills.add<PassiveSkill>("Strength Aura", 10);
+    skills.add<ActiveSkill>("Fireball", 5);
+    skills.add<PassiveSkill>("Agility Aura", 7);
+    skills.add<ActiveSkill>("Lightning Strike", 12);
+
+    RenderVisitor render;
+    StatsVisitor stats;
+    skills.accept(render);
+    skills.accept(stats);
+    stats.print_result();
+}
+
+// 基准：同一组技能，shared_ptr + 双分派 与 SkillArray + std::visit 分别跑 StatsVisitor
+inline void visitor_benchmark(std::size_t node_count = 2000000, int rounds = 20)
+{
+    using Clock = std::chrono::steady_clock;
+    std::vector<std::shared_ptr<SkillNode>> nodes;
+    SkillArray values;
+    nodes.reserve(node_count);
+    values.reserve(node_count);
+    for (std::size_t i = 0; i < node_count; ++i)
+    {
+        // 伪随机交错两种技能，避免分支预测器把类型完全猜中
+        const bool passive = ((i * 2654435761u) >> 7) & 1;
+        const int data = static_cast<int>(i % 50);
+        const std::string name = passive ? "Aura" : "Strike";
+        if (passive)
+        {
+            nodes.push_back(std::make_shared<PassiveSkill>(name, data));
+            values.add<PassiveSkill>(name, data);
+        }
+        else
+        {
+            nodes.push_back(std::make_shared<ActiveSkill>(name, data));
+            values.add<ActiveSkill>(name, data);
+        }
+    }
+
+    StatsVisitor by_pointer;
+    auto t0 = Clock::now();
+    for (int r = 0; r < rounds; ++r)
+    {
+        StatsVisitor stats;
+        for (auto &node : nodes)
+        {
+            node->accept(stats);
+        }
+        by_pointer = stats;
+    }
+    auto t1 = Clock::now();
+
+    StatsVisitor by_value;
+    for (int r = 0; r < rounds; ++r)
+    {
+        StatsVisitor stats;
+        values.accept(stats);
+        by_value = stats;
+    }
+    auto t2 = Clock::now();
+
+    const double visits = double(node_count) * rounds;
+    auto mps = [visits](Clock::duration d)
+    { return visits / std::chrono::duration<double>(d).count() / 1e6; };
+    const bool same = by_pointer.passive_count() == by_value.passive_count()
+                      && by_pointer.active_count() == by_value.active_count()
+                      && by_pointer.total_bonus() == by_value.total_bonus();
+    printf("[Bench] %zu skills x %d rounds (%s)\n", node_count, rounds, same ? "match" : "MISMATCH");
+    printf("  double dispatch : %8.1f M visits/s\n", mps(t1 - t0));
+    printf("  variant + visit : %8.1f M visits/s\n", mps(t2 - t1));
+}
@@ -0,0 +1,114 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <tuple>
+
+#include "visitor.h"
+
+// 组合访问者：一次遍历中，每个节点依次交给 N 个访问者
+// 访问者以引用保存在 std::tuple 里，visit 用折叠表达式展开成 N 次直接调用，
+// 没有额外的虚函数层；节点只从内存里取一次，后面 N-1 次访问都命中缓存
+template <typename... Visitors>
+class FusedVisitor
+{
+public:
+    explicit FusedVisitor(Visitors &...visitors) : m_visitors(visitors...) {}
+
+    template <typename Skill>
+    void visit(Skill &skill)
+    {
+        std::apply([&skill](auto &...visitor) { (visitor.visit(skill), ...); }, m_visitors);
+    }
+
+private:
+    std::tuple<Visitors &...> m_visitors;
+};
+
+template <typename... Visitors>
+FusedVisitor<Visitors...> fuse(Visitors &...visitors)
+{
+    return FusedVisitor<Visitors...>(visitors...);
+}
+
+inline void visitor_fused_test()
+{
+    SkillArray skills;
+    skills.add<PassiveSkill>("Strength Aura", 10);
+    skills.add<ActiveSkill>("Fireball", 5);
+    skills.add<PassiveSkill>("Agility Aura", 7);
+    skills.add<ActiveSkill>("Lightning Strike", 12);
+
+    RenderVisitor render;
+    StatsVisitor stats;
+    auto both = fuse(render, stats); // 一次遍历完成渲染与统计
+    skills.accept(both);
+    stats.print_result();
+}
+
+// 基准：四个分析访问者，各跑一遍 vs 组合后只跑一遍
+inline void visitor_fused_benchmark(std::size_t node_count = 4000000, int rounds = 5)
+{
+    using Clock = std::chrono::steady_clock;
+
+    // 几个典型的“每帧分析”访问者
+    struct MaxBonusVisitor
+    {
+        int max_bonus{0};
+        void visit(PassiveSkill &skill) { max_bonus = std::max(max_bonus, skill.data()); }
+        void visit(ActiveSkill &) {}
+    };
+    struct CooldownVisitor
+    {
+        long long ready{0}; // 冷却不超过 10 秒的主动技能
+        void visit(PassiveSkill &) {}
+        void visit(ActiveSkill &skill) { ready += skill.data() <= 10; }
+    };
+    struct NameVisitor
+    {
+        std::size_t name_bytes{0};
+        void visit(SkillNode &skill) { name_bytes += skill.name().size(); }
+    };
+
+    SkillArray skills;
+    skills.reserve(node_count);
+    for (std::size_t i = 0; i < node_count; ++i)
+    {
+        const int data = static_cast<int>(i % 50);
+        if (((i * 2654435761u) >> 7) & 1) skills.add<PassiveSkill>("Aura", data);
+        else skills.add<ActiveSkill>("Strike", data);
+    }
+
+    StatsVisitor stats_a, stats_b;
+    MaxBonusVisitor max_a, max_b;
+    CooldownVisitor cool_a, cool_b;
+    NameVisitor name_a, name_b;
+
+    auto t0 = Clock::now();
+    for (int r = 0; r < rounds; ++r)
+    {
+        stats_a = {}; max_a = {}; cool_a = {}; name_a = {};
+        skills.accept(stats_a);
+        skills.accept(max_a);
+        skills.accept(cool_a);
+        skills.accept(name_a);
+    }
+    auto t1 = Clock::now();
+    for (int r = 0; r < rounds; ++r)
+    {
+        stats_b = {}; max_b = {}; cool_b = {}; name_b = {};
+        auto all = fuse(stats_b, max_b, cool_b, name_b);
+        skills.accept(all);
+    }
+    auto t2 = Clock::now();
+
+    const bool same = stats_a.total_bonus() == stats_b.total_bonus()
+                      && stats_a.passive_count() == stats_b.passive_count()
+                      && max_a.max_bonus == max_b.max_bonus && cool_a.ready == cool_b.ready
+                      && name_a.name_bytes == name_b.name_bytes;
+    auto ms = [rounds](Clock::duration d)
+    { return std::chrono::duration<double, std::milli>(d).count() / rounds; };
+    printf("[Bench] %zu skills, 4 visitors (%s)\n", node_count, same ? "match" : "MISMATCH");
+    printf("  4 separate passes: %8.2f ms/frame\n", ms(t1 - t0));
+    printf("  1 fused pass     : %8.2f ms/frame\n", ms(t2 - t1));
+}
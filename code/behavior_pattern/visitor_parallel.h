@@ -0,0 +1,182 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "visitor.h"
+
+// 并行遍历：把节点区间切成若干段，每个工作线程拿到访问者的一份空白副本（clone）独立访问，
+// 最后在调用线程上按段的顺序依次 merge 回原访问者
+// - 访问者需要提供 merge(const Visitor &)；副本优先调用 clone()，没有 clone() 时默认构造。
+//   副本必须是“空”的：merge 把它的全部结果加到原访问者上
+// - 没有 merge 的访问者（如 RenderVisitor）依赖访问顺序或有副作用，自动退回顺序遍历
+// - 各段按顺序合并，merge 满足结合律即可得到与顺序遍历相同的结果
+namespace skill_detail
+{
+template <typename Visitor, typename = void>
+struct has_clone : std::false_type
+{
+};
+
+template <typename Visitor>
+struct has_clone<Visitor, std::void_t<decltype(std::declval<const Visitor &>().clone())>> : std::true_type
+{
+};
+
+template <typename Visitor, typename = void>
+struct is_mergeable : std::false_type
+{
+};
+
+template <typename Visitor>
+struct is_mergeable<Visitor, std::void_t<decltype(std::declval<Visitor &>().merge(std::declval<const Visitor &>()))>>
+    : std::bool_constant<has_clone<Visitor>::value || std::is_default_constructible_v<Visitor>>
+{
+};
+
+template <typename Visitor>
+Visitor make_clone(const Visitor &visitor)
+{
+    if constexpr (has_clone<Visitor>::value) return visitor.clone();
+    else return Visitor{};
+}
+} // namespace skill_detail
+
+struct ParallelVisitOptions
+{
+    std::size_t threads{std::max(1u, std::thread::hardware_concurrency())};
+    std::size_t min_chunk{16384}; // 每段至少这么多节点，太小的区间不值得开线程
+};
+
+// accept_range(visitor, first, last) 负责访问一段节点
+template <typename Visitor, typename AcceptRange>
+void parallel_accept_range(std::size_t count, Visitor &visitor, AcceptRange &&accept_range,
+                           const ParallelVisitOptions &options = {})
+{
+    std::size_t threads = std::min(options.threads, count / std::max<std::size_t>(1, options.min_chunk));
+    if constexpr (!skill_detail::is_mergeable<Visitor>::value)
+    {
+        threads = 1;
+    }
+    if (threads <= 1)
+    {
+        accept_range(visitor, 0, count);
+        return;
+    }
+
+    if constexpr (skill_detail::is_mergeable<Visitor>::value)
+    {
+        std::vector<Visitor> clones;
+        clones.reserve(threads);
+        for (std::size_t t = 0; t < threads; ++t)
+        {
+            clones.push_back(skill_detail::make_clone(visitor));
+        }
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        auto bounds = [count, threads](std::size_t t) { return count * t / threads; };
+        for (std::size_t t = 1; t < threads; ++t)
+        {
+            workers.emplace_back([&, t] { accept_range(clones[t], bounds(t), bounds(t + 1)); });
+        }
+        accept_range(clones[0], bounds(0), bounds(1)); // 第一段在调用线程上执行
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+        for (const auto &clone : clones)
+        {
+            visitor.merge(clone);
+        }
+    }
+}
+
+template <typename Visitor>
+void parallel_accept(SkillArray &skills, Visitor &visitor, const ParallelVisitOptions &options = {})
+{
+    parallel_accept_range(skills.size(), visitor,
+                          [&skills](auto &v, std::size_t first, std::size_t last) { skills.accept(v, first, last); },
+                          options);
+}
+
+template <typename Visitor>
+void parallel_accept(std::vector<std::shared_ptr<SkillNode>> &skills, Visitor &visitor,
+                     const ParallelVisitOptions &options = {})
+{
+    parallel_accept_range(skills.size(), visitor,
+                          [&skills](auto &v, std::size_t first, std::size_t last)
+                          {
+                              for (std::size_t i = first; i < last; ++i)
+                              {
+                                  skills[i]->accept(v);
+                              }
+                          },
+                          options);
+}
+
+inline void visitor_parallel_test()
+{
+    SkillArray skills;
+    for (int i = 0; i < 100000; ++i)
+    {
+        if (i % 3 == 0) skills.add<ActiveSkill>("Fireball", i % 20);
+        else skills.add<PassiveSkill>("Strength Aura", i % 10);
+    }
+
+    StatsVisitor sequential;
+    skills.accept(sequential);
+    ParallelVisitOptions options;
+    options.threads = 4;
+    options.min_chunk = 1000;
+    StatsVisitor parallel;
+    parallel_accept(skills, parallel, options);
+    sequential.print_result();
+    parallel.print_result();
+
+    SkillArray few;
+    few.add<PassiveSkill>("Strength Aura", 10);
+    few.add<ActiveSkill>("Fireball", 5);
+    RenderVisitor render; // 没有 merge：顺序执行，输出顺序不变
+    parallel_accept(few, render, options);
+}
+
+// 基准：同一组技能，StatsVisitor 分别用 1~16 个线程遍历；节点数越多、单节点工作越重，扩展越好
+inline void visitor_parallel_benchmark(std::size_t node_count = 20000000, int rounds = 5)
+{
+    using Clock = std::chrono::steady_clock;
+    SkillArray skills;
+    skills.reserve(node_count);
+    for (std::size_t i = 0; i < node_count; ++i)
+    {
+        const int data = static_cast<int>(i % 50);
+        if (((i * 2654435761u) >> 7) & 1) skills.add<PassiveSkill>("Aura", data);
+        else skills.add<ActiveSkill>("Strike", data);
+    }
+
+    StatsVisitor reference;
+    skills.accept(reference);
+    printf("[Bench] %zu skills, StatsVisitor, %u hardware threads\n", node_count,
+           std::thread::hardware_concurrency());
+    for (std::size_t threads : {1, 2, 4, 8, 16})
+    {
+        ParallelVisitOptions options;
+        options.threads = threads;
+        StatsVisitor result;
+        auto start = Clock::now();
+        for (int r = 0; r < rounds; ++r)
+        {
+            StatsVisitor stats;
+            parallel_accept(skills, stats, options);
+            result = stats;
+        }
+        const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / rounds;
+        const bool same = result.passive_count() == reference.passive_count()
+                          && result.active_count() == reference.active_count()
+                          && result.total_bonus() == reference.total_bonus();
+        printf("  %2zu threads: %8.2f ms/pass %s\n", threads, ms, same ? "match" : "MISMATCH");
+    }
+}
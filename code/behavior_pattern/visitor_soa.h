@@ -0,0 +1,188 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "visitor.h"
+
+// 按类型分区的技能存储：每种技能一个分区，分区内名字与数值各自连续存放（SoA）
+// - 访问者提供 visit_all(SkillColumn<T>) 时，每个分区只调用一次，统计类访问只扫 int 数组
+// - 否则走逐元素路径：访问者提供 visit(SkillView<T>)（如 RenderVisitor）时直接传列元素的只读视图，
+//   没有拷贝；只提供 visit(const T&) 的访问者才临时构造节点，每个元素拷贝一次名字（可能分配内存）
+// 存储在 accept 期间只读：视图是 const 引用，回退路径的临时节点也是 const，访问者改不了数据
+// 分区存储不保留技能之间的插入顺序，只保留同类技能内部的顺序
+namespace skill_detail
+{
+template <typename Visitor, typename Skill, typename = void>
+struct has_visit_all : std::false_type
+{
+};
+
+template <typename Visitor, typename Skill>
+struct has_visit_all<Visitor, Skill,
+                     std::void_t<decltype(std::declval<Visitor &>().visit_all(std::declval<SkillColumn<Skill>>()))>>
+    : std::true_type
+{
+};
+
+template <typename Visitor, typename Skill, typename = void>
+struct has_visit_view : std::false_type
+{
+};
+
+template <typename Visitor, typename Skill>
+struct has_visit_view<Visitor, Skill,
+                      std::void_t<decltype(std::declval<Visitor &>().visit(std::declval<SkillView<Skill>>()))>>
+    : std::true_type
+{
+};
+} // namespace skill_detail
+
+class SkillPartitions
+{
+public:
+    template <typename Skill>
+    void add(std::string name, int data)
+    {
+        Partition &partition = partition_of<Skill>();
+        partition.names.push_back(std::move(name));
+        partition.data.push_back(data);
+    }
+
+    template <typename Skill>
+    void reserve(std::size_t count)
+    {
+        partition_of<Skill>().names.reserve(count);
+        partition_of<Skill>().data.reserve(count);
+    }
+
+    std::size_t size() const { return m_passive.data.size() + m_active.data.size(); }
+
+    template <typename Visitor>
+    void accept(Visitor &visitor) const
+    {
+        accept_partition<PassiveSkill>(visitor, m_passive);
+        accept_partition<ActiveSkill>(visitor, m_active);
+    }
+
+private:
+    struct Partition
+    {
+        std::vector<std::string> names;
+        std::vector<int> data;
+    };
+
+    template <typename Skill>
+    Partition &partition_of()
+    {
+        static_assert(std::is_same_v<Skill, PassiveSkill> || std::is_same_v<Skill, ActiveSkill>);
+        if constexpr (std::is_same_v<Skill, PassiveSkill>) return m_passive;
+        else return m_active;
+    }
+
+    template <typename Skill, typename Visitor>
+    static void accept_partition(Visitor &visitor, const Partition &partition)
+    {
+        if constexpr (skill_detail::has_visit_all<Visitor, Skill>::value)
+        {
+            visitor.visit_all(SkillColumn<Skill>{partition.names.data(), partition.data.data(),
+                                                 partition.data.size()});
+        }
+        else if constexpr (skill_detail::has_visit_view<Visitor, Skill>::value)
+        {
+            for (std::size_t i = 0; i < partition.data.size(); ++i)
+            {
+                visitor.visit(SkillView<Skill>{partition.names[i], partition.data[i]});
+            }
+        }
+        else
+        {
+            // 回退：临时节点拷贝了名字，只能以 const 访问，需要 visit(const Skill&)
+            for (std::size_t i = 0; i < partition.data.size(); ++i)
+            {
+                const Skill node(partition.names[i], partition.data[i]);
+                visitor.visit(node);
+            }
+        }
+    }
+
+    Partition m_passive;
+    Partition m_active;
+};
+
+inline void visitor_soa_test()
+{
+    SkillPartitions skills;
+    skills.add<PassiveSkill>("Strength Aura", 10);
+    skills.add<ActiveSkill>("Fireball", 5);
+    skills.add<PassiveSkill>("Agility Aura", 7);
+    skills.add<ActiveSkill>("Lightning Strike", 12);
+
+    RenderVisitor render; // 逐元素视图路径，按分区顺序输出
+    StatsVisitor stats;   // 批量路径
+    skills.accept(render);
+    skills.accept(stats);
+    stats.print_result();
+}
+
+// 基准：passive_count 个被动 + 十分之一数量的主动技能，StatsVisitor 在三种存储上各跑 rounds 轮
+inline void visitor_soa_benchmark(std::size_t passive_count = 10000000, int rounds = 10)
+{
+    using Clock = std::chrono::steady_clock;
+    const std::size_t active_count = passive_count / 10;
+    std::vector<std::shared_ptr<SkillNode>> nodes;
+    SkillArray values;
+    SkillPartitions partitions;
+    nodes.reserve(passive_count + active_count);
+    values.reserve(passive_count + active_count);
+    partitions.reserve<PassiveSkill>(passive_count);
+    partitions.reserve<ActiveSkill>(active_count);
+    for (std::size_t i = 0; i < passive_count + active_count; ++i)
+    {
+        const int data = static_cast<int>(i % 50);
+        if (i % 11 == 10)
+        {
+            nodes.push_back(std::make_shared<ActiveSkill>("Strike", data));
+            values.add<ActiveSkill>("Strike", data);
+            partitions.add<ActiveSkill>("Strike", data);
+        }
+        else
+        {
+            nodes.push_back(std::make_shared<PassiveSkill>("Aura", data));
+            values.add<PassiveSkill>("Aura", data);
+            partitions.add<PassiveSkill>("Aura", data);
+        }
+    }
+
+    auto run = [rounds](auto &&pass)
+    {
+        StatsVisitor result;
+        auto start = Clock::now();
+        for (int r = 0; r < rounds; ++r)
+        {
+            StatsVisitor stats;
+            pass(stats);
+            result = stats;
+        }
+        return std::make_pair(result, std::chrono::duration<double>(Clock::now() - start).count() / rounds);
+    };
+    const auto pointer = run([&](StatsVisitor &stats) { for (auto &node : nodes) node->accept(stats); });
+    const auto variant = run([&](StatsVisitor &stats) { values.accept(stats); });
+    const auto soa = run([&](StatsVisitor &stats) { partitions.accept(stats); });
+
+    auto same = [](const StatsVisitor &a, const StatsVisitor &b)
+    {
+        return a.passive_count() == b.passive_count() && a.active_count() == b.active_count()
+               && a.total_bonus() == b.total_bonus();
+    };
+    const double data_gb = double(passive_count) * sizeof(int) / 1e9;
+    printf("[Bench] %zu passives + %zu actives, StatsVisitor (%s)\n", passive_count, active_count,
+           same(pointer.first, variant.first) && same(variant.first, soa.first) ? "match" : "MISMATCH");
+    printf("  shared_ptr + double dispatch: %8.2f ms/pass\n", pointer.second * 1e3);
+    printf("  SkillArray + std::visit     : %8.2f ms/pass\n", variant.second * 1e3);
+    printf("  SkillPartitions visit_all   : %8.2f ms/pass (%.1f GB/s of passive data)\n",
+           soa.second * 1e3, data_gb / soa.second);
+}
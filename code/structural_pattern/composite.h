@@ -3,6 +3,102 @@
 #include <memory>
 #include <vector>
 #include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+// 子树汇总：文件数、总字节数、最大深度（叶子为 0，目录为子节点最大深度 + 1）
+struct Aggregate
+{
+    std::size_t file_count{0};
+    std::uint64_t byte_size{0};
+    std::size_t max_depth{0};
+};
+
+// TreeWriter：show() 的缓冲版本使用的输出缓冲区
+// - 所有行追加到同一块可增长的缓冲区，缩进从预先准备好的空格串里整段拷贝，不构造临时 std::string
+// - 缓冲区攒够 flush_bytes 再整块 fwrite 一次（大块写入时 stdio 直接交给系统调用，不再二次拷贝）
+// - 构造时先刷新 std::cout，保证和之前经 cout 输出的内容顺序一致；析构时写出剩余内容
+class TreeWriter
+{
+public:
+    explicit TreeWriter(std::FILE* out = stdout, std::size_t flush_bytes = 1 << 20)
+    : m_out(out), m_flush_bytes(flush_bytes), m_capacity(flush_bytes + 4096),
+      m_buffer(new char[m_capacity])
+    {
+        std::cout.flush();
+    }
+
+    ~TreeWriter() { flush(); }
+
+    TreeWriter(const TreeWriter&) = delete;
+    TreeWriter& operator=(const TreeWriter&) = delete;
+
+    // 一行：indent 个空格 + marker + 空格 + name + 换行
+    void line(int indent, char marker, const std::string& name)
+    {
+        const std::size_t width = indent > 0 ? static_cast<std::size_t>(indent) : 0;
+        reserve(width + name.size() + 3);
+        char* p = m_buffer.get() + m_size;
+        for (std::size_t left = width; left > 0;)
+        {
+            const std::size_t run = std::min(left, sizeof(kSpaces) - 1);
+            std::memcpy(p, kSpaces, run);
+            p += run;
+            left -= run;
+        }
+        *p++ = marker;
+        *p++ = ' ';
+        std::memcpy(p, name.data(), name.size());
+        p += name.size();
+        *p++ = '\n';
+        m_size = static_cast<std::size_t>(p - m_buffer.get());
+        if (m_size >= m_flush_bytes)
+        {
+            flush();
+        }
+    }
+
+    // 写出缓冲区里的全部内容；返回目前为止是否都写成功
+    bool flush()
+    {
+        if (m_size > 0)
+        {
+            m_ok = std::fwrite(m_buffer.get(), 1, m_size, m_out) == m_size && m_ok;
+            m_size = 0;
+        }
+        m_ok = std::fflush(m_out) == 0 && m_ok;
+        return m_ok;
+    }
+
+private:
+    static constexpr char kSpaces[] = "                                                                "; // 64 个空格
+
+    void reserve(std::size_t extra)
+    {
+        if (m_size + extra <= m_capacity)
+        {
+            return;
+        }
+        // 超长的行（极深的缩进或很长的名字）才会走到这里
+        const std::size_t capacity = std::max(m_capacity * 2, m_size + extra);
+        std::unique_ptr<char[]> grown(new char[capacity]);
+        std::memcpy(grown.get(), m_buffer.get(), m_size);
+        m_buffer = std::move(grown);
+        m_capacity = capacity;
+    }
+
+    std::FILE* m_out;
+    std::size_t m_flush_bytes;
+    std::size_t m_capacity;
+    std::unique_ptr<char[]> m_buffer;
+    std::size_t m_size{0};
+    bool m_ok{true};
+};
 
 // Component：所有“节点”的统一接口（无论叶子或组合都继承自它）
 class Component
@@ -17,12 +113,35 @@ public:
     // 统一接口：客户端始终通过 show() 操作节点，不需要区分叶子/组合
     virtual void show(int indent = 0) const = 0;
 
+    // 与 show() 输出相同，但写入 TreeWriter 的缓冲区；节点很多时用这个
+    virtual void render(TreeWriter& out, int indent = 0) const = 0;
+
     // 透明接口：Leaf 默认忽略 add/remove，Composite 覆盖它们
     virtual void add(std::shared_ptr<Component>) {}
     virtual void remove(const std::shared_ptr<Component>&) {}
 
+    // 整棵子树的汇总；Directory 缓存结果，没有变化时 O(1)
+    virtual Aggregate aggregate() const = 0;
+
+    std::size_t file_count() const { return aggregate().file_count; }
+    std::uint64_t byte_size() const { return aggregate().byte_size; }
+    std::size_t max_depth() const { return aggregate().max_depth; }
+
+    Component *parent() const { return m_parent; }
+
 protected:
+    // 子树发生变化：沿父链接向上把缓存标记为失效
+    virtual void invalidate()
+    {
+        if (m_parent)
+        {
+            m_parent->invalidate();
+        }
+    }
+
     std::string m_name;
+    Component *m_parent{nullptr}; // 所在目录；一个节点同一时刻只能挂在一个目录下
+    friend class Directory;
 };
 
 // Composite：可以包含子节点的“目录”
@@ -33,6 +152,15 @@ public:
     : Component(std::move(name))
     {}
 
+    // 子节点可能被别处的 shared_ptr 继续持有：目录销毁时清掉它们的父链接，避免悬空
+    ~Directory() override
+    {
+        for (const auto& child : m_children)
+        {
+            child->m_parent = nullptr;
+        }
+    }
+
     void show(int indent = 0) const override
     {
         // indent 控制缩进；递归展示目录树
@@ -43,35 +171,105 @@ public:
         }
     }
 
+    void render(TreeWriter& out, int indent = 0) const override
+    {
+        out.line(indent, '+', m_name);
+        for (const auto& child : m_children)
+        {
+            child->render(out, indent + 2);
+        }
+    }
+
+    // 已经挂在别的目录下的节点先从原目录摘下（原目录的汇总随之失效），再挂到这里
     void add(std::shared_ptr<Component> node) override
     {
+        if (node->m_parent)
+        {
+            node->m_parent->remove(node);
+        }
+        node->m_parent = this;
         m_children.emplace_back(std::move(node)); // 组合包含叶子或其它组合
+        invalidate();
     }
 
     void remove(const std::shared_ptr<Component>& node) override
     {
         // std::remove + erase：删除 vector 中指定元素的典型做法
-        m_children.erase(
-            std::remove(m_children.begin(), m_children.end(), node),
-            m_children.end());
+        auto it = std::remove(m_children.begin(), m_children.end(), node);
+        if (it == m_children.end())
+        {
+            return;
+        }
+        m_children.erase(it, m_children.end());
+        node->m_parent = nullptr;
+        invalidate();
+    }
+
+    // 缓存失效时只重新汇总脏的子目录，干净的子节点直接返回缓存
+    // 查询会写缓存（mutable），多线程同时查询需要外部加锁
+    Aggregate aggregate() const override
+    {
+        if (m_dirty)
+        {
+            Aggregate total;
+            for (const auto& child : m_children)
+            {
+                const Aggregate sub = child->aggregate();
+                total.file_count += sub.file_count;
+                total.byte_size += sub.byte_size;
+                total.max_depth = std::max(total.max_depth, sub.max_depth + 1);
+            }
+            m_cache = total;
+            m_dirty = false;
+        }
+        return m_cache;
+    }
+
+protected:
+    // 已经是脏的就停：它的祖先在它变脏时已经一并标记过
+    void invalidate() override
+    {
+        if (m_dirty)
+        {
+            return;
+        }
+        m_dirty = true;
+        Component::invalidate();
     }
 
 private:
     std::vector<std::shared_ptr<Component>> m_children;
+    mutable Aggregate m_cache;
+    mutable bool m_dirty{true};
 };
 
 // Leaf：不含子节点的“文件”
 class File : public Component
 {
 public:
-    explicit File(std::string name)
-    : Component(std::move(name))
+    explicit File(std::string name, std::uint64_t size = 0)
+    : Component(std::move(name)), m_size(size)
     {}
 
+    std::uint64_t size() const { return m_size; }
+
+    void resize(std::uint64_t size)
+    {
+        m_size = size;
+        invalidate();
+    }
+
+    Aggregate aggregate() const override { return {1, m_size, 0}; }
+
     void show(int indent = 0) const override
     {
         std::cout << std::string(indent, ' ') << "- " << m_name << '\n';
     }
+
+    void render(TreeWriter& out, int indent = 0) const override { out.line(indent, '-', m_name); }
+
+private:
+    std::uint64_t m_size;
 };
 
 // 简单测试：展示目录树
@@ -93,4 +291,155 @@ inline void composite_test()
     root->add(std::make_shared<File>("readme.md"));
 
     root->show();
-}
\ No newline at end of file
+}
+// 子树汇总：增删节点或改文件大小后，只有变动路径上的目录需要重新汇总
+inline void composite_aggregate_test()
+{
+    auto root     = std::make_shared<Directory>("root");
+    auto docs     = std::make_shared<Directory>("docs");
+    auto textures = std::make_shared<Directory>("textures");
+    auto report   = std::make_shared<File>("report.txt", 1200);
+    docs->add(report);
+    docs->add(std::make_shared<File>("notes.md", 300));
+    textures->add(std::make_shared<File>("ui.png", 40960));
+    root->add(docs);
+    root->add(textures);
+
+    auto print = [&root](const char* when)
+    {
+        std::printf("%-22s files=%zu bytes=%llu depth=%zu\n", when, root->file_count(),
+                    static_cast<unsigned long long>(root->byte_size()), root->max_depth());
+    };
+    print("initial:");
+    report->resize(5000);
+    print("report.txt resized:");
+    auto deep = std::make_shared<Directory>("mipmaps");
+    deep->add(std::make_shared<File>("ui_1.png", 10240));
+    textures->add(deep);
+    print("mipmaps added:");
+    root->remove(docs);
+    print("docs removed:");
+
+    // 换目录：report.txt 从 docs 挪到 textures，docs 的汇总同步变化
+    textures->add(report);
+    std::printf("%-22s docs files=%zu, root files=%zu\n", "report.txt moved:", docs->file_count(), root->file_count());
+
+    // 子节点比目录活得久：目录销毁后父链接清空，之后修改文件不会访问已释放的目录
+    auto orphan = std::make_shared<File>("orphan.log", 1);
+    {
+        auto temp = std::make_shared<Directory>("temp");
+        temp->add(orphan);
+    }
+    orphan->resize(5);
+    std::printf("%-22s parent=%s size=%llu\n", "orphan outlived dir:", orphan->parent() ? "dangling" : "none",
+                static_cast<unsigned long long>(orphan->size()));
+}
+
+// 基准：dir_count 个目录、每个目录 files_per_dir 个文件的随机树
+//   冷查询：所有缓存失效，相当于不带缓存时每次查询都要做的全树汇总
+//   热查询：没有变化，直接返回缓存
+//   改一个文件后查询：只重新汇总这个文件到根的路径
+inline void composite_benchmark(std::size_t dir_count = 100000, std::size_t files_per_dir = 9, int rounds = 1000)
+{
+    using Clock = std::chrono::steady_clock;
+    std::vector<std::shared_ptr<Directory>> dirs{std::make_shared<Directory>("root")};
+    std::vector<std::shared_ptr<File>> files;
+    for (std::size_t i = 1; i < dir_count; ++i)
+    {
+        auto dir = std::make_shared<Directory>("dir" + std::to_string(i));
+        dirs[((i * 2654435761u) >> 12) % dirs.size()]->add(dir);
+        dirs.push_back(dir);
+    }
+    for (std::size_t i = 0; i < dir_count * files_per_dir; ++i)
+    {
+        auto file = std::make_shared<File>("file" + std::to_string(i), i % 4096);
+        dirs[(i * 40503u) % dirs.size()]->add(file);
+        files.push_back(file);
+    }
+    const Directory& root = *dirs[0];
+
+    auto t0 = Clock::now();
+    const Aggregate cold = root.aggregate();
+    auto t1 = Clock::now();
+    std::uint64_t sink = 0;
+    for (int r = 0; r < rounds; ++r)
+    {
+        sink += root.byte_size();
+    }
+    auto t2 = Clock::now();
+    for (int r = 0; r < rounds; ++r)
+    {
+        files[(r * 7919u) % files.size()]->resize(r);
+        sink += root.byte_size();
+    }
+    auto t3 = Clock::now();
+
+    auto ns = [](Clock::duration d) { return std::chrono::duration<double, std::nano>(d).count(); };
+    std::printf("[Bench] %zu nodes, %zu files, %llu bytes, max depth %zu (sink %llu)\n",
+                dirs.size() + files.size(), cold.file_count, static_cast<unsigned long long>(cold.byte_size),
+                cold.max_depth, static_cast<unsigned long long>(sink));
+    std::printf("  cold query (full recompute): %12.0f ns\n", ns(t1 - t0));
+    std::printf("  clean query                : %12.1f ns\n", ns(t2 - t1) / rounds);
+    std::printf("  resize one file + query    : %12.1f ns\n", ns(t3 - t2) / rounds);
+}
+
+// 基准：约 node_count 个节点的目录树（每个目录 9 个文件），分别写入临时文件后比对内容
+//   show()：把 std::cout 重定向到文件流（已经跳过了与 stdio 的同步，是 cout 路径里较快的情况）
+//   render()：TreeWriter 缓冲，整块 fwrite
+inline void composite_show_benchmark(std::size_t node_count = 1000000)
+{
+    using Clock = std::chrono::steady_clock;
+    const std::size_t dir_count = std::max<std::size_t>(1, node_count / 10);
+    std::vector<std::shared_ptr<Directory>> dirs{std::make_shared<Directory>("root")};
+    for (std::size_t i = 1; i < dir_count; ++i)
+    {
+        auto dir = std::make_shared<Directory>("dir" + std::to_string(i));
+        dirs[((i * 2654435761u) >> 12) % dirs.size()]->add(dir);
+        dirs.push_back(dir);
+    }
+    for (std::size_t i = dir_count; i < node_count; ++i)
+    {
+        dirs[(i * 40503u) % dirs.size()]->add(std::make_shared<File>("file" + std::to_string(i) + ".dat"));
+    }
+
+    const auto temp = std::filesystem::temp_directory_path();
+    const std::string by_show = (temp / "composite_show.txt").string();
+    const std::string by_render = (temp / "composite_render.txt").string();
+
+    auto t0 = Clock::now();
+    {
+        std::ofstream file(by_show, std::ios::binary);
+        std::streambuf* saved = std::cout.rdbuf(file.rdbuf());
+        dirs[0]->show();
+        std::cout.flush();
+        std::cout.rdbuf(saved);
+    }
+    auto t1 = Clock::now();
+    bool written = false;
+    if (std::FILE* fp = std::fopen(by_render.c_str(), "wb"))
+    {
+        {
+            TreeWriter out(fp);
+            dirs[0]->render(out);
+            written = out.flush();
+        }
+        std::fclose(fp);
+    }
+    auto t2 = Clock::now();
+
+    auto slurp = [](const std::string& path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    };
+    const std::string expected = slurp(by_show);
+    const bool same = written && expected == slurp(by_render);
+    std::remove(by_show.c_str());
+    std::remove(by_render.c_str());
+
+    auto ms = [](Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); };
+    std::printf("[Bench] %zu nodes, %zu bytes of output (%s)\n", node_count, expected.size(),
+                same ? "identical" : "MISMATCH");
+    std::printf("  show() via std::cout : %8.1f ms\n", ms(t1 - t0));
+    std::printf("  render() TreeWriter  : %8.1f ms\n", ms(t2 - t1));
+}
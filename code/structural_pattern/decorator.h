@@ -2,6 +2,8 @@
 #include <iostream>
 #include <memory>
 
+#include "../utility/trace.h"
+
 // 统一接口：渲染器
 class IRenderer
 {
@@ -16,7 +18,7 @@ class BasicRenderer : public IRenderer
 public:
     void render() override
     {
-        std::printf("render base scene.\n");
+        TRACE_DEBUG("render base scene.");
     }
 };
 
@@ -40,9 +42,9 @@ public:
 
     void render() override
     {
-        std::printf("enable bloom.\n");
+        TRACE_DEBUG("enable bloom.");
         m_inner->render();
-        std::printf("disable bloom.\n");
+        TRACE_DEBUG("disable bloom.");
     }
 };
 
@@ -54,9 +56,9 @@ public:
 
     void render() override
     {
-        std::printf("enable shadow.\n");
+        TRACE_DEBUG("enable shadow.");
         m_inner->render();
-        std::printf("disable shadow.\n");
+        TRACE_DEBUG("disable shadow.");
     }
 };
 
@@ -66,12 +68,16 @@ inline void decorator_test()
     auto bloom = std::make_shared<BloomDecorator>(base);
     auto shadow = std::make_shared<ShadowDecorator>(bloom);
 
+    // 段落标题不在热路径上，直接 puts；先 flush，让上一段的追踪输出排在标题前面
     std::puts("== base ==");
     base->render();
 
+    trace::flush();
     std::puts("== bloom ==");
     bloom->render();
 
+    trace::flush();
     std::puts("== bloom + shadow ==");
     shadow->render();
+    trace::flush();
 }
@@ -0,0 +1,210 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+
+// EpochDomain：基于纪元（epoch）的延迟回收，供 RCU 式读多写少的数据使用
+// - 读者进入临界区时把全局纪元写进自己的线程记录，离开时清零；不碰引用计数
+// - 写者替换指针后把旧对象连同当时的纪元放进待回收列表，并推进全局纪元
+// - 只有当所有仍在临界区内的读者纪元都大于旧对象的退休纪元时，旧对象才被释放
+class EpochDomain
+{
+    struct alignas(64) Record
+    {
+        std::atomic<std::uint64_t> epoch{0}; // 0 表示不在临界区
+        std::atomic<bool> in_use{false};
+    };
+
+    struct Retired
+    {
+        void *ptr;
+        void (*deleter)(void *);
+        std::uint64_t epoch;
+    };
+
+    // 每个线程首次进入临界区时占用一条记录，线程退出时归还
+    struct LocalState
+    {
+        Record *record{nullptr};
+        int depth{0};
+
+        ~LocalState()
+        {
+            if (record)
+            {
+                record->epoch.store(0, std::memory_order_release);
+                record->in_use.store(false, std::memory_order_release);
+            }
+        }
+    };
+
+public:
+    static constexpr std::size_t kMaxThreads = 256;
+
+    static EpochDomain &instance()
+    {
+        static EpochDomain domain;
+        return domain;
+    }
+
+    // 读者临界区（RAII，可嵌套，只有最外层生效）
+    class Guard
+    {
+    public:
+        Guard() : m_local(EpochDomain::instance().local())
+        {
+            if (m_local.depth++ == 0)
+            {
+                m_local.record->epoch.store(
+                    EpochDomain::instance().m_global.load(std::memory_order_relaxed),
+                    std::memory_order_relaxed);
+                // 全屏障：保证“写纪元”先于随后对共享指针的读取对写者可见
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+        }
+
+        ~Guard()
+        {
+            if (--m_local.depth == 0)
+            {
+                m_local.record->epoch.store(0, std::memory_order_release);
+            }
+        }
+
+        Guard(const Guard &) = delete;
+        Guard &operator=(const Guard &) = delete;
+
+    private:
+        LocalState &m_local;
+    };
+
+    // 写者调用：旧对象交给纪元系统，稍后安全释放
+    void retire(void *ptr, void (*deleter)(void *))
+    {
+        if (!ptr)
+        {
+            return;
+        }
+        const std::uint64_t epoch = m_global.fetch_add(1, std::memory_order_seq_cst);
+        std::lock_guard<std::mutex> lock(m_retire_mutex);
+        m_retired.push_back({ptr, deleter, epoch});
+        reclaim_locked();
+    }
+
+    // 尝试释放已经没有读者可能持有的对象，返回释放个数
+    std::size_t reclaim()
+    {
+        std::lock_guard<std::mutex> lock(m_retire_mutex);
+        return reclaim_locked();
+    }
+
+    std::size_t pending() const
+    {
+        std::lock_guard<std::mutex> lock(m_retire_mutex);
+        return m_retired.size();
+    }
+
+    ~EpochDomain()
+    {
+        for (const auto &item : m_retired)
+        {
+            item.deleter(item.ptr); // 进程退出：不再有读者
+        }
+    }
+
+private:
+    EpochDomain() = default;
+
+    LocalState &local()
+    {
+        thread_local LocalState state;
+        if (!state.record)
+        {
+            for (auto &record : m_records)
+            {
+                bool expected = false;
+                if (record.in_use.compare_exchange_strong(expected, true))
+                {
+                    state.record = &record;
+                    break;
+                }
+            }
+            if (!state.record)
+            {
+                std::fputs("[Epoch] too many reader threads\n", stderr);
+                std::abort();
+            }
+        }
+        return state;
+    }
+
+    std::size_t reclaim_locked()
+    {
+        // 与读者的屏障配对：先完成指针替换，再扫描读者纪元
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::uint64_t min_active = UINT64_MAX;
+        for (const auto &record : m_records)
+        {
+            const std::uint64_t epoch = record.epoch.load(std::memory_order_seq_cst);
+            if (epoch != 0 && epoch < min_active)
+            {
+                min_active = epoch;
+            }
+        }
+
+        std::size_t freed = 0;
+        for (std::size_t i = 0; i < m_retired.size();)
+        {
+            if (m_retired[i].epoch < min_active)
+            {
+                m_retired[i].deleter(m_retired[i].ptr);
+                m_retired[i] = m_retired.back();
+                m_retired.pop_back();
+                ++freed;
+            }
+            else
+            {
+                ++i;
+            }
+        }
+        return freed;
+    }
+
+    std::atomic<std::uint64_t> m_global{1};
+    Record m_records[kMaxThreads];
+
+    mutable std::mutex m_retire_mutex;
+    std::vector<Retired> m_retired;
+};
+
+// RcuSlot：单个可热替换的对象槽
+// - 读者：在 EpochDomain::Guard 内调用 load()，一次 acquire 读取，无引用计数
+// - 写者：publish() 原子替换，旧对象延迟到没有读者时释放
+template <typename T>
+class RcuSlot
+{
+public:
+    RcuSlot() = default;
+    explicit RcuSlot(T *initial) : m_ptr(initial) {}
+
+    ~RcuSlot() { delete m_ptr.load(std::memory_order_relaxed); }
+
+    RcuSlot(const RcuSlot &) = delete;
+    RcuSlot &operator=(const RcuSlot &) = delete;
+
+    // 必须在 Guard 作用域内使用返回值
+    T *load() const { return m_ptr.load(std::memory_order_acquire); }
+
+    // 接管 next 的所有权；旧对象交给纪元系统回收
+    void publish(T *next)
+    {
+        T *old = m_ptr.exchange(next, std::memory_order_acq_rel);
+        EpochDomain::instance().retire(old, [](void *p) { delete static_cast<T *>(p); });
+    }
+
+private:
+    std::atomic<T *> m_ptr{nullptr};
+};
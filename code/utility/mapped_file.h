@@ -0,0 +1,168 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// MappedFile：只读内存映射文件（RAII），析构时自动解除映射
+// 读取方直接拿到 data()/size() 视图，不需要把整个文件拷贝进 std::string
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string &path) { open(path); }
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    MappedFile(MappedFile &&other) noexcept { swap(other); }
+    MappedFile &operator=(MappedFile &&other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            swap(other);
+        }
+        return *this;
+    }
+
+    bool open(const std::string &path)
+    {
+        close();
+#ifdef _WIN32
+        m_file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                               nullptr, OPEN_EXISTING,
+                               FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (m_file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+        LARGE_INTEGER size{};
+        if (!::GetFileSizeEx(m_file, &size))
+        {
+            close();
+            return false;
+        }
+        m_size = static_cast<std::size_t>(size.QuadPart);
+        if (m_size == 0)
+        {
+            return true; // 空文件：合法但没有映射
+        }
+        m_mapping = ::CreateFileMappingA(m_file, nullptr, PAGE_READONLY,
+                                         0, 0, nullptr);
+        if (!m_mapping)
+        {
+            close();
+            return false;
+        }
+        m_data = static_cast<const char *>(
+            ::MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!m_data)
+        {
+            close();
+            return false;
+        }
+#else
+        m_fd = ::open(path.c_str(), O_RDONLY);
+        if (m_fd < 0)
+        {
+            return false;
+        }
+        struct stat st{};
+        if (::fstat(m_fd, &st) != 0)
+        {
+            close();
+            return false;
+        }
+        m_size = static_cast<std::size_t>(st.st_size);
+        if (m_size == 0)
+        {
+            return true;
+        }
+        void *addr = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+        if (addr == MAP_FAILED)
+        {
+            close();
+            return false;
+        }
+        m_data = static_cast<const char *>(addr);
+        ::madvise(addr, m_size, MADV_SEQUENTIAL); // 顺序读提示，加大预读
+#endif
+        return true;
+    }
+
+    void close()
+    {
+#ifdef _WIN32
+        if (m_data) ::UnmapViewOfFile(m_data);
+        if (m_mapping) ::CloseHandle(m_mapping);
+        if (m_file != INVALID_HANDLE_VALUE) ::CloseHandle(m_file);
+        m_mapping = nullptr;
+        m_file = INVALID_HANDLE_VALUE;
+#else
+        if (m_data) ::munmap(const_cast<char *>(m_data), m_size);
+        if (m_fd >= 0) ::close(m_fd);
+        m_fd = -1;
+#endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    bool is_open() const
+    {
+#ifdef _WIN32
+        return m_file != INVALID_HANDLE_VALUE;
+#else
+        return m_fd >= 0;
+#endif
+    }
+
+    const char *data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+
+    // 逐页触碰一次，把缺页/磁盘读取提前到调用线程（流水线的 I/O 阶段使用）
+    void prefault() const
+    {
+        constexpr std::size_t kPage = 4096;
+        volatile char sink = 0;
+        for (std::size_t off = 0; off < m_size; off += kPage)
+        {
+            sink = sink + m_data[off];
+        }
+        (void)sink;
+    }
+
+private:
+    void swap(MappedFile &other) noexcept
+    {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+#ifdef _WIN32
+        std::swap(m_file, other.m_file);
+        std::swap(m_mapping, other.m_mapping);
+#else
+        std::swap(m_fd, other.m_fd);
+#endif
+    }
+
+    const char *m_data{nullptr};
+    std::size_t m_size{0};
+#ifdef _WIN32
+    HANDLE m_file{INVALID_HANDLE_VALUE};
+    HANDLE m_mapping{nullptr};
+#else
+    int m_fd{-1};
+#endif
+};
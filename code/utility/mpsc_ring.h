@@ -0,0 +1,87 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// MpscRing：多生产者/单消费者的有界无锁环形缓冲区
+// - 每个槽位带一个序号：序号 == 写入位置 表示可写，== 写入位置 + 1 表示已写好可读
+// - 生产者用 CAS 抢占 m_tail 上的位置，写完数据后再发布序号；消费者独占 m_head，不需要原子读改写
+// - 同一生产者先后 push 的元素按顺序出队；不同生产者之间按抢到位置的先后排序
+// - 某个生产者抢到位置但还没发布时，消费者在它前面停下，后面的元素留到下一次 pop_batch
+// - 容量 N 必须是 2 的幂；满时 try_push 返回 false
+template <typename T, std::size_t N>
+class MpscRing
+{
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "capacity must be a power of two");
+
+public:
+    MpscRing()
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    static constexpr std::size_t capacity() { return N; }
+
+    // 任意生产者线程调用
+    bool try_push(const T &value)
+    {
+        std::size_t pos = m_tail.load(std::memory_order_relaxed);
+        Slot *slot;
+        for (;;)
+        {
+            slot = &m_slots[pos & (N - 1)];
+            const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+            if (diff == 0)
+            {
+                if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // 这个槽位上一轮的数据还没被取走：队列已满
+            }
+            else
+            {
+                pos = m_tail.load(std::memory_order_relaxed); // 被别的生产者抢先，重新读位置
+            }
+        }
+        slot->value = value;
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 消费者线程调用：一次取走最多 max_count 个已发布的元素，返回实际个数
+    std::size_t pop_batch(T *out, std::size_t max_count)
+    {
+        std::size_t count = 0;
+        while (count < max_count)
+        {
+            Slot &slot = m_slots[m_head & (N - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != m_head + 1)
+            {
+                break;
+            }
+            out[count++] = slot.value;
+            slot.sequence.store(m_head + N, std::memory_order_release); // 交还给下一轮的生产者
+            ++m_head;
+        }
+        return count;
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<std::size_t> sequence;
+        T value{};
+    };
+
+    alignas(64) std::atomic<std::size_t> m_tail{0};
+    alignas(64) std::size_t m_head{0};
+    alignas(64) std::array<Slot, N> m_slots;
+};
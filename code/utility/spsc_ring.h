@@ -0,0 +1,59 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// SpscRing：单生产者/单消费者的无锁环形缓冲区
+// - 容量 N 必须是 2 的幂，下标用位与回绕
+// - 生产者只写 m_tail，消费者只写 m_head，各自独占一条缓存行
+// - 满时 try_push 返回 false，由调用方决定丢弃还是重试
+template <typename T, std::size_t N>
+class SpscRing
+{
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "capacity must be a power of two");
+
+public:
+    static constexpr std::size_t capacity() { return N; }
+
+    // 生产者线程调用
+    bool try_push(const T &value)
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == N)
+        {
+            return false;
+        }
+        m_items[tail & (N - 1)] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 消费者线程调用：一次取走最多 max_count 个元素，返回实际个数
+    std::size_t pop_batch(T *out, std::size_t max_count)
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        const std::size_t tail = m_tail.load(std::memory_order_acquire);
+        std::size_t count = tail - head;
+        if (count > max_count)
+        {
+            count = max_count;
+        }
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            out[i] = m_items[(head + i) & (N - 1)];
+        }
+        m_head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    bool empty() const
+    {
+        return m_head.load(std::memory_order_acquire)
+               == m_tail.load(std::memory_order_acquire);
+    }
+
+private:
+    alignas(64) std::atomic<std::size_t> m_head{0};
+    alignas(64) std::atomic<std::size_t> m_tail{0};
+    alignas(64) std::array<T, N> m_items{};
+};
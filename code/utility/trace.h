@@ -0,0 +1,455 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "spsc_ring.h"
+
+// 低开销二进制追踪：替代热路径上的 printf/std::cout
+// - 生产者只往本线程的无锁环形缓冲写一条定长记录（格式串指针 + 参数），不做格式化
+// - 后台线程批量取走记录，按时间戳合并后格式化并一次性 fwrite
+// - 编译期级别过滤：低于 DP_TRACE_LEVEL 的 TRACE_xxx 展开为空，参数也不会求值
+// 格式串必须是字符串字面量（只保存指针），占位符写作 {}；
+// 最多 4 个参数，字符串参数会截断拷贝进记录：被截断的参数输出时带 "..." 标记
+// 丢弃（缓冲满）和截断都会计数，写出时附一行 [Trace] 汇总，累计值见 Tracer::stats()
+// 输出是异步的：和 printf/puts 混用时，先 trace::flush() 再打印，否则顺序会交错
+#define DP_TRACE_LEVEL_DEBUG 0
+#define DP_TRACE_LEVEL_INFO  1
+#define DP_TRACE_LEVEL_WARN  2
+#define DP_TRACE_LEVEL_ERROR 3
+#define DP_TRACE_LEVEL_OFF   4
+
+#ifndef DP_TRACE_LEVEL
+#define DP_TRACE_LEVEL DP_TRACE_LEVEL_DEBUG
+#endif
+
+namespace trace
+{
+enum class Level : std::uint8_t
+{
+    Debug = DP_TRACE_LEVEL_DEBUG,
+    Info = DP_TRACE_LEVEL_INFO,
+    Warn = DP_TRACE_LEVEL_WARN,
+    Error = DP_TRACE_LEVEL_ERROR,
+    Off = DP_TRACE_LEVEL_OFF
+};
+
+enum class ArgKind : std::uint8_t
+{
+    Int,
+    UInt,
+    Float,
+    Str
+};
+
+// 定长记录：96 字节，按值拷贝进环形缓冲
+struct Record
+{
+    std::uint64_t ns;         // steady_clock 时间戳，用于跨线程合并排序
+    const char *fmt;          // 字面量格式串
+    std::uint64_t args[4];    // 整数/浮点的原始位
+    char text[37];            // 字符串参数，依次以 '\0' 分隔
+    std::uint8_t argc;
+    ArgKind kinds[4];
+    Level level;
+    std::uint8_t truncated;   // 按位：第 i 个参数被截断
+};
+
+static_assert(sizeof(Record) == 96, "trace record should stay compact");
+
+namespace detail
+{
+constexpr std::size_t kRingSize = 1024;
+
+struct ThreadBuffer
+{
+    SpscRing<Record, kRingSize> ring;
+    std::atomic<std::size_t> dropped{0};
+    std::atomic<std::size_t> truncated{0}; // 含截断参数的记录数
+    std::atomic<bool> retired{false};      // 所属线程已退出，不会再写入
+};
+
+// 参数编码：按类型写入 Record，字符串截断拷贝
+class ArgWriter
+{
+public:
+    explicit ArgWriter(Record &record) : m_record(record) {}
+
+    template <typename T>
+    void put(const T &value)
+    {
+        using D = std::decay_t<T>;
+        if constexpr (std::is_same_v<D, bool> || std::is_enum_v<D>)
+        {
+            push(ArgKind::Int, static_cast<std::uint64_t>(static_cast<std::int64_t>(value)));
+        }
+        else if constexpr (std::is_integral_v<D> && std::is_signed_v<D>)
+        {
+            push(ArgKind::Int, static_cast<std::uint64_t>(static_cast<std::int64_t>(value)));
+        }
+        else if constexpr (std::is_integral_v<D>)
+        {
+            push(ArgKind::UInt, static_cast<std::uint64_t>(value));
+        }
+        else if constexpr (std::is_floating_point_v<D>)
+        {
+            const double d = static_cast<double>(value);
+            std::uint64_t bits;
+            std::memcpy(&bits, &d, sizeof(bits));
+            push(ArgKind::Float, bits);
+        }
+        else
+        {
+            put_text(std::string_view(value));
+        }
+    }
+
+private:
+    void push(ArgKind kind, std::uint64_t bits)
+    {
+        m_record.kinds[m_record.argc] = kind;
+        m_record.args[m_record.argc] = bits;
+        ++m_record.argc;
+    }
+
+    void put_text(std::string_view text)
+    {
+        const std::size_t room = sizeof(m_record.text) - m_text_used - 1;
+        const std::size_t len = std::min(room, text.size());
+        std::memcpy(m_record.text + m_text_used, text.data(), len);
+        m_record.text[m_text_used + len] = '\0';
+        if (len < text.size())
+        {
+            m_record.truncated |= static_cast<std::uint8_t>(1u << m_record.argc);
+        }
+        push(ArgKind::Str, static_cast<std::uint64_t>(m_text_used));
+        m_text_used += len + 1;
+        if (m_text_used >= sizeof(m_record.text))
+        {
+            m_text_used = sizeof(m_record.text) - 1; // 后续字符串参数为空
+        }
+    }
+
+    Record &m_record;
+    std::size_t m_text_used{0};
+};
+
+// 把一条记录按 {} 占位符展开，追加到 out
+inline void format_record(const Record &record, std::string &out)
+{
+    char number[32];
+    std::size_t next = 0;
+    for (const char *p = record.fmt; *p; ++p)
+    {
+        if (p[0] == '{' && p[1] == '}' && next < record.argc)
+        {
+            const std::uint64_t bits = record.args[next];
+            int len = 0;
+            switch (record.kinds[next])
+            {
+            case ArgKind::Int:
+                len = std::snprintf(number, sizeof(number), "%lld",
+                                    static_cast<long long>(static_cast<std::int64_t>(bits)));
+                break;
+            case ArgKind::UInt:
+                len = std::snprintf(number, sizeof(number), "%llu",
+                                    static_cast<unsigned long long>(bits));
+                break;
+            case ArgKind::Float:
+            {
+                double d;
+                std::memcpy(&d, &bits, sizeof(d));
+                len = std::snprintf(number, sizeof(number), "%g", d);
+                break;
+            }
+            case ArgKind::Str:
+                out += record.text + bits;
+                if (record.truncated & (1u << next))
+                {
+                    out += "...";
+                }
+                break;
+            }
+            if (len > 0)
+            {
+                out.append(number, static_cast<std::size_t>(len));
+            }
+            ++next;
+            ++p;
+            continue;
+        }
+        out += *p;
+    }
+    out += '\n';
+}
+} // namespace detail
+
+// Tracer：管理所有线程的缓冲区与后台格式化线程（进程内单例）
+class Tracer
+{
+public:
+    // 累计统计：只包含已写出的批次，读之前先 flush()
+    struct Stats
+    {
+        std::size_t dropped{0};
+        std::size_t truncated{0};
+        std::size_t buffers{0}; // 当前登记的线程缓冲数（线程退出且写完后回收）
+    };
+
+    static Tracer &instance()
+    {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    // 运行期级别：用于临时静音（如跑基准），编译期过滤仍由 DP_TRACE_LEVEL 决定
+    void set_runtime_level(Level level) { m_runtime_level.store(level, std::memory_order_relaxed); }
+    Level runtime_level() const { return m_runtime_level.load(std::memory_order_relaxed); }
+    bool enabled(Level level) const
+    {
+        return level >= m_runtime_level.load(std::memory_order_relaxed);
+    }
+
+    void set_output(std::FILE *out)
+    {
+        std::lock_guard<std::mutex> lock(m_drain_mutex);
+        m_out = out;
+    }
+
+    template <typename... Args>
+    void emit(Level level, const char *fmt, const Args &...args)
+    {
+        static_assert(sizeof...(Args) <= 4, "trace supports at most 4 arguments");
+        Record record;
+        record.ns = static_cast<std::uint64_t>(
+            std::chrono::steady_clock::now().time_since_epoch().count());
+        record.fmt = fmt;
+        record.argc = 0;
+        record.level = level;
+        record.truncated = 0;
+        detail::ArgWriter writer(record);
+        (writer.put(args), ...);
+
+        detail::ThreadBuffer &buffer = local_buffer();
+        if (!buffer.ring.try_push(record))
+        {
+            buffer.dropped.fetch_add(1, std::memory_order_relaxed); // 满了就丢，不阻塞热路径
+        }
+        else if (record.truncated)
+        {
+            buffer.truncated.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // 同步取走并写出当前所有记录（退出前、或需要和普通输出对齐时调用）
+    void flush()
+    {
+        std::lock_guard<std::mutex> lock(m_drain_mutex);
+        drain_locked();
+    }
+
+    Stats stats()
+    {
+        std::lock_guard<std::mutex> lock(m_drain_mutex);
+        Stats stats = m_stats;
+        std::lock_guard<std::mutex> registry(m_registry_mutex);
+        stats.buffers = m_buffers.size();
+        return stats;
+    }
+
+    ~Tracer()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_wake_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_one();
+        if (m_worker.joinable())
+        {
+            m_worker.join();
+        }
+        flush();
+    }
+
+private:
+    Tracer() = default;
+
+    detail::ThreadBuffer &local_buffer()
+    {
+        // 每个线程首次写入时注册自己的缓冲；线程退出时标记 retired，
+        // 缓冲仍由 Tracer 持有，等下一次 drain 把剩余记录写完后从 m_buffers 中移除
+        struct Owner
+        {
+            std::shared_ptr<detail::ThreadBuffer> buffer;
+            ~Owner() { buffer->retired.store(true, std::memory_order_release); }
+        };
+        thread_local Owner owner{[this]
+        {
+            auto created = std::make_shared<detail::ThreadBuffer>();
+            std::lock_guard<std::mutex> lock(m_registry_mutex);
+            m_buffers.push_back(created);
+            if (!m_worker.joinable())
+            {
+                m_worker = std::thread([this] { run(); });
+            }
+            return created;
+        }()};
+        return *owner.buffer;
+    }
+
+    void run()
+    {
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_wake_mutex);
+                m_wake.wait_for(lock, std::chrono::milliseconds(2),
+                                [this] { return m_stop; });
+                if (m_stop)
+                {
+                    return;
+                }
+            }
+            flush();
+        }
+    }
+
+    // 调用方需持有 m_drain_mutex：保证每个环形缓冲只有一个消费者
+    void drain_locked()
+    {
+        std::vector<std::shared_ptr<detail::ThreadBuffer>> buffers;
+        {
+            std::lock_guard<std::mutex> lock(m_registry_mutex);
+            buffers = m_buffers;
+        }
+
+        m_batch.clear();
+        Record chunk[64];
+        std::size_t dropped = 0;
+        std::size_t truncated = 0;
+        std::size_t retired = 0;
+        for (auto &buffer : buffers)
+        {
+            // 先读 retired：看到 true 时线程的所有写入都已可见，下面取空之后就不会再有新记录
+            const bool exited = buffer->retired.load(std::memory_order_acquire);
+            std::size_t count;
+            while ((count = buffer->ring.pop_batch(chunk, 64)) > 0)
+            {
+                m_batch.insert(m_batch.end(), chunk, chunk + count);
+            }
+            dropped += buffer->dropped.exchange(0, std::memory_order_relaxed);
+            truncated += buffer->truncated.exchange(0, std::memory_order_relaxed);
+            if (!exited)
+            {
+                buffer.reset(); // 留在 buffers 里的只剩可以回收的
+            }
+            else
+            {
+                ++retired;
+            }
+        }
+        if (retired > 0)
+        {
+            std::lock_guard<std::mutex> lock(m_registry_mutex);
+            m_buffers.erase(std::remove_if(m_buffers.begin(), m_buffers.end(),
+                                           [&buffers](const std::shared_ptr<detail::ThreadBuffer> &b)
+                                           { return std::find(buffers.begin(), buffers.end(), b) != buffers.end(); }),
+                            m_buffers.end());
+        }
+        if (m_batch.empty() && dropped == 0)
+        {
+            return;
+        }
+        m_stats.dropped += dropped;
+        m_stats.truncated += truncated;
+
+        // 各线程内部已有序，合并时按时间戳稳定排序
+        std::stable_sort(m_batch.begin(), m_batch.end(),
+                         [](const Record &a, const Record &b) { return a.ns < b.ns; });
+
+        m_text.clear();
+        for (const auto &record : m_batch)
+        {
+            detail::format_record(record, m_text);
+        }
+        if (dropped > 0)
+        {
+            m_text += "[Trace] dropped " + std::to_string(dropped) + " records (ring full)\n";
+        }
+        if (truncated > 0)
+        {
+            m_text += "[Trace] truncated string args in " + std::to_string(truncated) +
+                      " records (marked ...)\n";
+        }
+        std::FILE *out = m_out ? m_out : stdout;
+        std::fwrite(m_text.data(), 1, m_text.size(), out);
+        std::fflush(out);
+    }
+
+    std::atomic<Level> m_runtime_level{Level::Debug};
+
+    std::mutex m_registry_mutex;
+    std::vector<std::shared_ptr<detail::ThreadBuffer>> m_buffers;
+
+    std::mutex m_drain_mutex;
+    std::vector<Record> m_batch; // 复用的合并缓冲
+    std::string m_text;          // 复用的格式化缓冲
+    std::FILE *m_out{nullptr};
+    Stats m_stats;
+
+    std::mutex m_wake_mutex;
+    std::condition_variable m_wake;
+    bool m_stop{false};
+    std::thread m_worker;
+};
+
+inline void flush() { Tracer::instance().flush(); }
+inline Tracer::Stats stats() { return Tracer::instance().stats(); }
+inline void set_runtime_level(Level level) { Tracer::instance().set_runtime_level(level); }
+inline Level runtime_level() { return Tracer::instance().runtime_level(); }
+} // namespace trace
+
+#define DP_TRACE_EMIT(level, ...)                                   \
+    do                                                              \
+    {                                                               \
+        auto &dp_tracer_ = ::trace::Tracer::instance();             \
+        if (dp_tracer_.enabled(level))                              \
+        {                                                           \
+            dp_tracer_.emit(level, __VA_ARGS__);                    \
+        }                                                           \
+    } while (0)
+
+#if DP_TRACE_LEVEL <= DP_TRACE_LEVEL_DEBUG
+#define TRACE_DEBUG(...) DP_TRACE_EMIT(::trace::Level::Debug, __VA_ARGS__)
+#else
+#define TRACE_DEBUG(...) ((void)0)
+#endif
+
+#if DP_TRACE_LEVEL <= DP_TRACE_LEVEL_INFO
+#define TRACE_INFO(...) DP_TRACE_EMIT(::trace::Level::Info, __VA_ARGS__)
+#else
+#define TRACE_INFO(...) ((void)0)
+#endif
+
+#if DP_TRACE_LEVEL <= DP_TRACE_LEVEL_WARN
+#define TRACE_WARN(...) DP_TRACE_EMIT(::trace::Level::Warn, __VA_ARGS__)
+#else
+#define TRACE_WARN(...) ((void)0)
+#endif
+
+#if DP_TRACE_LEVEL <= DP_TRACE_LEVEL_ERROR
+#define TRACE_ERROR(...) DP_TRACE_EMIT(::trace::Level::Error, __VA_ARGS__)
+#else
+#define TRACE_ERROR(...) ((void)0)
+#endif